@@ -0,0 +1,80 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "typed_frame.h"
+
+using namespace df;
+
+namespace {
+// keeps results observable so timed calls are not optimized away
+volatile double sink{};
+
+// best of several runs in milliseconds
+template <typename Func>
+double time_ms(Func func, size_t repeats = 3) {
+  double best{};
+  for (size_t r{}; r < repeats; ++r) {
+    auto start{std::chrono::steady_clock::now()};
+    func();
+    std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+using Quotes = TypedFrame<Col<"ts", int64_t>, Col<"venue", std::string>,
+                          Col<"bid", double>, Col<"ask", double>,
+                          Col<"size", int64_t>>;
+}  // namespace
+
+int main() {
+  const size_t n{2'000'000};
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "bench_quotes.csv"};
+  {
+    std::mt19937_64 gen{3};
+    std::uniform_real_distribution<double> prices(90.0, 110.0);
+    std::uniform_int_distribution<int64_t> sizes(1, 5000);
+    const char* venues[]{"XNAS", "ARCX", "BATS", "IEXG"};
+
+    std::ofstream file{path};
+    file << std::setprecision(10) << "ts,venue,bid,ask,size\n";
+    int64_t ts{1'700'000'000'000'000'000};
+    for (size_t i{}; i < n; ++i) {
+      double bid{prices(gen)};
+      file << (ts += 1000) << ',' << venues[i % 4] << ',' << bid << ','
+           << bid + 0.01 << ',' << sizes(gen) << '\n';
+    }
+  }
+
+  const std::unordered_map<std::string, ColumnType> types{
+      {"ts", ColumnType::Int64},   {"venue", ColumnType::String},
+      {"bid", ColumnType::Double}, {"ask", ColumnType::Double},
+      {"size", ColumnType::Int64}};
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(24) << "reader" << std::right
+            << std::setw(12) << "ms" << '\n';
+
+  std::cout << std::left << std::setw(24) << "from_csv typed" << std::right
+            << std::setw(12) << time_ms([&] {
+                 DataFrame frame{};
+                 frame.from_csv(path.string(), types);
+                 sink = frame.nrows();
+               })
+            << '\n';
+
+  std::cout << std::left << std::setw(24) << "read_csv<Quotes>" << std::right
+            << std::setw(12) << time_ms([&] {
+                 sink = read_csv<Quotes>(path.string()).nrows();
+               })
+            << '\n';
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dataframe.h"
+
+using namespace df;
+
+namespace {
+// keeps results observable so timed calls are not optimized away
+volatile double sink{};
+
+// best of several runs in milliseconds
+template <typename Func>
+double time_ms(Func func, size_t repeats = 3) {
+  double best{};
+  for (size_t r{}; r < repeats; ++r) {
+    auto start{std::chrono::steady_clock::now()};
+    func();
+    std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+DataFrame make(size_t n, size_t keys, uint64_t seed,
+               const std::string& suffix = "") {
+  std::mt19937_64 gen{seed};
+  std::uniform_int_distribution<int64_t> key(0, keys - 1);
+  std::uniform_real_distribution<double> price(90.0, 110.0);
+  const std::vector<std::string> venues{"XNAS", "ARCX", "BATS", "IEXG"};
+
+  std::vector<int64_t> ids(n);
+  std::vector<double> prices(n);
+  std::vector<std::string> names(n);
+  for (size_t i{}; i < n; ++i) {
+    ids[i] = key(gen);
+    prices[i] = i % 50 == 0 ? utils::get_null<double>() : price(gen);
+    names[i] = venues[i % venues.size()];
+  }
+
+  DataFrame frame{};
+  frame.add_column<int64_t>("id", ids);
+  frame.add_column<double>("px" + suffix, prices);
+  frame.add_column<std::string>("venue" + suffix, names);
+  return frame;
+}
+
+void report(const std::string& name, double ms) {
+  std::cout << std::left << std::setw(16) << name << std::right
+            << std::setw(12) << ms << '\n';
+}
+}  // namespace
+
+int main() {
+  const size_t n{500'000};
+  const DataFrame left{make(n, n, 1)};
+  const DataFrame right{make(n / 4, n, 2, "_r")};
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "bench_dispatch.csv"};
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(16) << "operation" << std::right
+            << std::setw(12) << "ms" << '\n';
+
+  report("to_csv", time_ms([&] { left.to_csv(path.string()); }));
+
+  report("print", time_ms([&] {
+           std::ostringstream discard{};
+           auto* previous{std::cout.rdbuf(discard.rdbuf())};
+           left.head(n);
+           std::cout.rdbuf(previous);
+           sink = discard.str().size();
+         }));
+
+  report("dropna", time_ms([&] {
+           DataFrame copy{left};
+           sink = copy.dropna().nrows();
+         }));
+
+  report("sort_by", time_ms([&] {
+           DataFrame copy{left};
+           sink = copy.sort_by("px").nrows();
+         }));
+
+  report("inner_join", time_ms([&] {
+           sink = DataFrame::inner_join(left, right, {"id"}).nrows();
+         }));
+
+  report("left_join", time_ms([&] {
+           sink = DataFrame::left_join(left, right, {"id"}).nrows();
+         }));
+
+  // small inputs, full_join used to reserve left x right rows up front
+  const DataFrame small_left{make(n / 100, n / 100, 3)};
+  const DataFrame small_right{make(n / 400, n / 100, 4, "_r")};
+  report("full_join 1%", time_ms([&] {
+           sink = DataFrame::full_join(small_left, small_right, {"id"}).nrows();
+         }));
+
+  report("anti_join", time_ms([&] {
+           sink = DataFrame::anti_join(left, right, {"id"}).nrows();
+         }));
+
+  std::filesystem::remove(path);
+}
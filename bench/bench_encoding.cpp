@@ -0,0 +1,105 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "encoding.h"
+
+using namespace df;
+
+namespace {
+// keeps results observable so timed calls are not optimized away
+volatile double sink{};
+
+// best of several runs in milliseconds
+template <typename Func>
+double time_ms(Func func, size_t repeats = 5) {
+  double best{};
+  for (size_t r{}; r < repeats; ++r) {
+    auto start{std::chrono::steady_clock::now()};
+    func();
+    std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+std::vector<int64_t> make(size_t n, const std::string& pattern) {
+  std::mt19937_64 gen{11};
+  std::vector<int64_t> values(n);
+
+  if (pattern == "timestamps") {
+    // nanosecond ticks with sub millisecond gaps
+    std::uniform_int_distribution<int64_t> gap(0, 400'000);
+    int64_t ts{1'700'000'000'000'000'000};
+    for (auto& value : values) {
+      value = ts += gap(gen);
+    }
+  } else if (pattern == "quantities") {
+    std::uniform_int_distribution<int64_t> lots(1, 50);
+    for (auto& value : values) {
+      value = lots(gen) * 100;
+    }
+  } else {
+    // side flags arriving in bursts
+    std::uniform_int_distribution<int64_t> burst(1, 200);
+    int64_t side{};
+    for (size_t i{}; i < n;) {
+      size_t end{std::min(n, i + static_cast<size_t>(burst(gen)))};
+      for (; i < end; ++i) {
+        values[i] = side;
+      }
+      side ^= 1;
+    }
+  }
+  return values;
+}
+}  // namespace
+
+int main() {
+  const size_t n{20'000'000};
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(12) << "column" << std::setw(12)
+            << "encoding" << std::right << std::setw(10) << "ratio"
+            << std::setw(12) << "sum ms" << std::setw(12) << "plain ms"
+            << std::setw(14) << "between ms" << std::setw(12) << "plain ms"
+            << '\n';
+
+  for (const std::string pattern : {"timestamps", "quantities", "sides"}) {
+    Column<int64_t> plain{make(n, pattern)};
+    EncodedColumn encoded{EncodedColumn::encode(plain)};
+
+    const char* names[]{"bitpacked", "delta", "runlength"};
+    double ratio{static_cast<double>(n * sizeof(int64_t)) /
+                 static_cast<double>(encoded.size_bytes())};
+
+    int64_t lo{plain[n / 2]};
+    int64_t hi{plain[n / 2 + n / 100]};
+    if (lo > hi) {
+      std::swap(lo, hi);
+    }
+
+    double encoded_sum{time_ms([&] { sink = encoded.sum(); })};
+    double plain_sum{time_ms([&] { sink = plain.sum(); })};
+    double encoded_between{time_ms(
+        [&] { sink = static_cast<double>(encoded.between(lo, hi).size()); })};
+    double plain_between{time_ms([&] {
+      std::vector<size_t> selection{};
+      for (size_t i{}; i < plain.nrows(); ++i) {
+        if (plain[i] >= lo && plain[i] <= hi) {
+          selection.push_back(i);
+        }
+      }
+      sink = static_cast<double>(selection.size());
+    })};
+
+    std::cout << std::left << std::setw(12) << pattern << std::setw(12)
+              << names[static_cast<size_t>(encoded.get_encoding())]
+              << std::right << std::setw(10) << ratio << std::setw(12)
+              << encoded_sum << std::setw(12) << plain_sum << std::setw(14)
+              << encoded_between << std::setw(12) << plain_between << '\n';
+  }
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sort.h"
+
+using namespace df;
+
+namespace {
+// keeps results observable so timed calls are not optimized away
+volatile size_t sink{};
+
+// best of several runs in milliseconds
+template <typename Func>
+double time_ms(Func func, size_t repeats = 5) {
+  double best{};
+  for (size_t r{}; r < repeats; ++r) {
+    auto start{std::chrono::steady_clock::now()};
+    func();
+    std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+std::vector<int64_t> timestamps(size_t n, const std::string& pattern) {
+  std::mt19937_64 gen{42};
+  std::vector<int64_t> values(n);
+  for (size_t i{}; i < n; ++i) {
+    values[i] = static_cast<int64_t>(i) * 1000;
+  }
+
+  if (pattern == "late bursts") {
+    // every ~10k rows a burst of 16 packets arrives 64 rows late
+    for (size_t i{10000}; i + 80 < n; i += 10000) {
+      std::rotate(values.begin() + i, values.begin() + i + 16,
+                  values.begin() + i + 80);
+    }
+  } else if (pattern == "jitter") {
+    // timestamps perturbed by up to a few neighbours of network jitter
+    std::uniform_int_distribution<int64_t> noise(-3000, 3000);
+    for (auto& value : values) {
+      value += noise(gen);
+    }
+  } else if (pattern == "interleaved") {
+    // eight presorted feeds appended one after another
+    std::vector<int64_t> feeds{};
+    for (size_t f{}; f < 8; ++f) {
+      for (size_t i{f}; i < n; i += 8) {
+        feeds.push_back(values[i]);
+      }
+    }
+    values = std::move(feeds);
+  } else if (pattern == "random") {
+    std::ranges::shuffle(values, gen);
+  }
+  return values;
+}
+
+std::vector<std::string> keys(size_t n, const std::string& pattern) {
+  std::mt19937_64 gen{7};
+  std::vector<std::string> values(n);
+
+  if (pattern == "symbols") {
+    // a few thousand short tickers
+    std::uniform_int_distribution<int> letter('A', 'Z');
+    std::vector<std::string> universe(5000);
+    for (auto& symbol : universe) {
+      symbol = std::string(4, ' ');
+      for (auto& c : symbol) {
+        c = static_cast<char>(letter(gen));
+      }
+    }
+    std::uniform_int_distribution<size_t> pick(0, universe.size() - 1);
+    for (auto& value : values) {
+      value = universe[pick(gen)];
+    }
+  } else {
+    // order ids sharing a long prefix, unique suffix
+    std::uniform_int_distribution<uint64_t> id(0, 1'000'000'000);
+    for (auto& value : values) {
+      value = "ORD-2024-NYSE-" + std::to_string(id(gen));
+    }
+  }
+  return values;
+}
+}  // namespace
+
+int main() {
+  const size_t n{10'000'000};
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(14) << "pattern" << std::right
+            << std::setw(14) << "introsort ms" << std::setw(14)
+            << "adaptive ms" << std::setw(14) << "is_sorted ms" << '\n';
+
+  for (const std::string pattern :
+       {"sorted", "late bursts", "jitter", "interleaved", "random"}) {
+    std::vector<int64_t> values{timestamps(n, pattern)};
+
+    double introsort{time_ms([&] {
+      sink = sort::argsort(values, true, SortMethod::Introsort).front();
+    })};
+    double adaptive{time_ms([&] {
+      sink = sort::argsort(values, true, SortMethod::Adaptive).front();
+    })};
+    double check{time_ms([&] { sink = sort::is_sorted(values, true); })};
+
+    std::cout << std::left << std::setw(14) << pattern << std::right
+              << std::setw(14) << introsort << std::setw(14) << adaptive
+              << std::setw(14) << check << '\n';
+  }
+
+  const size_t m{2'000'000};
+  std::cout << '\n'
+            << std::left << std::setw(14) << "strings" << std::right
+            << std::setw(14) << "introsort ms" << std::setw(14)
+            << "radix ms" << '\n';
+
+  for (const std::string pattern : {"symbols", "order ids"}) {
+    std::vector<std::string> values{keys(m, pattern)};
+
+    double introsort{time_ms(
+        [&] {
+          sink = sort::argsort(values, true, SortMethod::Introsort).front();
+        },
+        3)};
+    double radix{time_ms(
+        [&] { sink = sort::argsort(values, true).front(); }, 3)};
+
+    std::cout << std::left << std::setw(14) << pattern << std::right
+              << std::setw(14) << introsort << std::setw(14) << radix << '\n';
+  }
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "typed_frame.h"
+
+using namespace df;
+
+namespace {
+// keeps results observable so timed calls are not optimized away
+volatile double sink{};
+
+// best of several runs in milliseconds
+template <typename Func>
+double time_ms(Func func, size_t repeats = 5) {
+  double best{};
+  for (size_t r{}; r < repeats; ++r) {
+    auto start{std::chrono::steady_clock::now()};
+    func();
+    std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+using Quotes = TypedFrame<Col<"ts", int64_t>, Col<"px", double>>;
+
+void report(const std::string& name, double dynamic_ms, double typed_ms) {
+  std::cout << std::left << std::setw(16) << name << std::right
+            << std::setw(14) << dynamic_ms << std::setw(12) << typed_ms
+            << '\n';
+}
+}  // namespace
+
+int main() {
+  const size_t n{5'000'000};
+  std::mt19937_64 gen{5};
+  std::uniform_int_distribution<int64_t> ticks(0, 1'000'000'000);
+  std::uniform_real_distribution<double> prices(90.0, 110.0);
+
+  Quotes typed{};
+  typed.reserve(n);
+  for (size_t i{}; i < n; ++i) {
+    typed.append(ticks(gen), prices(gen));
+  }
+  const DataFrame dynamic{typed.to_dataframe()};
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(16) << "operation" << std::right
+            << std::setw(14) << "dynamic ms" << std::setw(12) << "typed ms"
+            << '\n';
+
+  report(
+      "row loop",
+      time_ms([&] {
+        const Column<double>& px{*dynamic.get_column<double>("px")};
+        double total{};
+        for (size_t i{}; i < px.nrows(); ++i) {
+          total += px[i];
+        }
+        sink = total;
+      }),
+      time_ms([&] {
+        double total{};
+        for (const double px : typed.values<"px">()) {
+          total += px;
+        }
+        sink = total;
+      }));
+
+  report(
+      "filter and sum",
+      time_ms([&] {
+        sink = dynamic.between<double>("px", 95.0, 96.0).sum("px");
+      }),
+      time_ms([&] {
+        sink = typed.filter<"px">([](double px) {
+                      return px >= 95.0 && px <= 96.0;
+                    }).sum<"px">();
+      }));
+
+  report("sort", time_ms([&] {
+           DataFrame copy{dynamic};
+           copy.sort_by("ts");
+           sink = copy.nrows();
+         }),
+         time_ms([&] {
+           Quotes copy{typed};
+           copy.sort_by<"ts">();
+           sink = copy.nrows();
+         }));
+}
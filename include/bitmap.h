@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "hash_table.h"
+#include "utils.h"
+
+namespace df {
+/*
+NOTE: roaring style compressed bitmap of row indices. rows are split on
+their high bits into chunks of 65536, each held in a sorted array of low 16
+bit values while it has at most array_limit rows and as a 65536 bit set
+beyond that. appending rows in ascending order never searches
+*/
+class RoaringBitmap {
+ public:
+  static constexpr size_t array_limit{4096};
+  static constexpr size_t dense_words{1024};
+
+ private:
+  struct Container {
+    uint64_t key{};
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bits;
+    size_t cardinality{};
+
+    bool dense() const { return !bits.empty(); }
+
+    bool contains(uint16_t low) const {
+      if (dense()) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+      }
+      return std::ranges::binary_search(array, low);
+    }
+
+    void add(uint16_t low) {
+      if (dense()) {
+        uint64_t& word{bits[low >> 6]};
+        uint64_t bit{uint64_t{1} << (low & 63)};
+        cardinality += (word & bit) == 0;
+        word |= bit;
+        return;
+      }
+
+      if (array.empty() || array.back() < low) {
+        array.push_back(low);
+      } else {
+        auto it{std::ranges::lower_bound(array, low)};
+        if (*it == low) {
+          return;
+        }
+        array.insert(it, low);
+      }
+      ++cardinality;
+
+      if (cardinality > array_limit) {
+        to_dense();
+      }
+    }
+
+    void to_dense() {
+      bits.assign(dense_words, 0);
+      for (const auto low : array) {
+        bits[low >> 6] |= uint64_t{1} << (low & 63);
+      }
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    // dense containers that fell back under the limit become arrays
+    void normalize() {
+      cardinality = 0;
+      if (!dense()) {
+        cardinality = array.size();
+        return;
+      }
+
+      for (const auto word : bits) {
+        cardinality += std::popcount(word);
+      }
+      if (cardinality <= array_limit) {
+        array.reserve(cardinality);
+        for_each([&](uint16_t low) { array.push_back(low); });
+        bits.clear();
+        bits.shrink_to_fit();
+      }
+    }
+
+    template <typename Func>
+    void for_each(Func func) const {
+      if (!dense()) {
+        for (const auto low : array) {
+          func(low);
+        }
+        return;
+      }
+
+      for (size_t w{}; w < dense_words; ++w) {
+        uint64_t word{bits[w]};
+        while (word != 0) {
+          func(static_cast<uint16_t>(w * 64 + std::countr_zero(word)));
+          word &= word - 1;
+        }
+      }
+    }
+  };
+
+  std::vector<Container> containers;  // ascending by key
+
+  Container* find_container(uint64_t key) {
+    auto it{std::ranges::lower_bound(containers, key, {}, &Container::key)};
+    return it != containers.end() && it->key == key ? &*it : nullptr;
+  }
+
+  const Container* find_container(uint64_t key) const {
+    auto it{std::ranges::lower_bound(containers, key, {}, &Container::key)};
+    return it != containers.end() && it->key == key ? &*it : nullptr;
+  }
+
+  static Container intersect(const Container& a, const Container& b) {
+    Container out{};
+    out.key = a.key;
+
+    if (a.dense() && b.dense()) {
+      out.bits.resize(dense_words);
+      for (size_t w{}; w < dense_words; ++w) {
+        out.bits[w] = a.bits[w] & b.bits[w];
+      }
+    } else if (a.dense() || b.dense()) {
+      const Container& sparse{a.dense() ? b : a};
+      const Container& dense{a.dense() ? a : b};
+      for (const auto low : sparse.array) {
+        if (dense.contains(low)) {
+          out.array.push_back(low);
+        }
+      }
+    } else {
+      std::ranges::set_intersection(a.array, b.array,
+                                    std::back_inserter(out.array));
+    }
+
+    out.normalize();
+    return out;
+  }
+
+  static Container unite(const Container& a, const Container& b) {
+    Container out{};
+    out.key = a.key;
+
+    if (!a.dense() && !b.dense() &&
+        a.cardinality + b.cardinality <= array_limit) {
+      std::ranges::set_union(a.array, b.array, std::back_inserter(out.array));
+    } else {
+      out.bits.assign(dense_words, 0);
+      for (const Container* side : {&a, &b}) {
+        if (side->dense()) {
+          for (size_t w{}; w < dense_words; ++w) {
+            out.bits[w] |= side->bits[w];
+          }
+        } else {
+          for (const auto low : side->array) {
+            out.bits[low >> 6] |= uint64_t{1} << (low & 63);
+          }
+        }
+      }
+    }
+
+    out.normalize();
+    return out;
+  }
+
+ public:
+  RoaringBitmap() = default;
+
+  static RoaringBitmap from_selection(const std::vector<size_t>& rows) {
+    RoaringBitmap bitmap{};
+    for (const auto row : rows) {
+      bitmap.add(row);
+    }
+    return bitmap;
+  }
+
+  void add(size_t row) {
+    uint64_t key{row >> 16};
+    uint16_t low{static_cast<uint16_t>(row & 0xffff)};
+
+    if (containers.empty() || containers.back().key < key) {
+      containers.emplace_back().key = key;
+      containers.back().add(low);
+      return;
+    }
+
+    if (Container* container{find_container(key)}) {
+      container->add(low);
+      return;
+    }
+
+    auto it{std::ranges::lower_bound(containers, key, {}, &Container::key)};
+    it = containers.insert(it, Container{});
+    it->key = key;
+    it->add(low);
+  }
+
+  bool contains(size_t row) const {
+    const Container* container{find_container(row >> 16)};
+    return container != nullptr &&
+           container->contains(static_cast<uint16_t>(row & 0xffff));
+  }
+
+  size_t size() const {
+    size_t total{};
+    for (const auto& container : containers) {
+      total += container.cardinality;
+    }
+    return total;
+  }
+
+  bool empty() const { return containers.empty(); }
+
+  size_t size_bytes() const {
+    size_t total{containers.size() * sizeof(Container)};
+    for (const auto& container : containers) {
+      total += container.array.size() * sizeof(uint16_t) +
+               container.bits.size() * sizeof(uint64_t);
+    }
+    return total;
+  }
+
+  // ascending row indices, ready for DataFrame::take
+  std::vector<size_t> to_selection() const {
+    std::vector<size_t> rows{};
+    rows.reserve(size());
+    for (const auto& container : containers) {
+      size_t base{static_cast<size_t>(container.key) << 16};
+      container.for_each([&](uint16_t low) { rows.push_back(base | low); });
+    }
+    return rows;
+  }
+
+  friend RoaringBitmap operator&(const RoaringBitmap& a,
+                                 const RoaringBitmap& b) {
+    RoaringBitmap out{};
+    auto left{a.containers.begin()};
+    auto right{b.containers.begin()};
+    while (left != a.containers.end() && right != b.containers.end()) {
+      if (left->key < right->key) {
+        ++left;
+      } else if (right->key < left->key) {
+        ++right;
+      } else {
+        Container both{intersect(*left++, *right++)};
+        if (both.cardinality > 0) {
+          out.containers.push_back(std::move(both));
+        }
+      }
+    }
+    return out;
+  }
+
+  friend RoaringBitmap operator|(const RoaringBitmap& a,
+                                 const RoaringBitmap& b) {
+    RoaringBitmap out{};
+    auto left{a.containers.begin()};
+    auto right{b.containers.begin()};
+    while (left != a.containers.end() || right != b.containers.end()) {
+      if (right == b.containers.end() ||
+          (left != a.containers.end() && left->key < right->key)) {
+        out.containers.push_back(*left++);
+      } else if (left == a.containers.end() || right->key < left->key) {
+        out.containers.push_back(*right++);
+      } else {
+        out.containers.push_back(unite(*left++, *right++));
+      }
+    }
+    return out;
+  }
+
+  bool operator==(const RoaringBitmap& other) const {
+    return to_selection() == other.to_selection();
+  }
+};
+
+/*
+one bitmap of rows per distinct value, built in one pass and extended row
+by row on append. nulls are not indexed
+*/
+template <typename T>
+class BitmapIndex {
+ private:
+  FlatHashMap<T, size_t> slots;  // value to bitmap position, offset by one
+  std::vector<RoaringBitmap> bitmaps;
+
+ public:
+  void add(size_t row, const T& value) {
+    if (utils::is_null(value)) {
+      return;
+    }
+
+    size_t& slot{slots[value]};
+    if (slot == 0) {
+      bitmaps.emplace_back();
+      slot = bitmaps.size();
+    }
+    bitmaps[slot - 1].add(row);
+  }
+
+  size_t distinct() const { return bitmaps.size(); }
+
+  const RoaringBitmap* find(const T& value) const {
+    const size_t* slot{slots.find(value)};
+    return slot != nullptr ? &bitmaps[*slot - 1] : nullptr;
+  }
+
+  RoaringBitmap any_of(const std::vector<T>& values) const {
+    RoaringBitmap rows{};
+    for (const auto& value : values) {
+      if (const RoaringBitmap* bitmap{find(value)}) {
+        rows = rows | *bitmap;
+      }
+    }
+    return rows;
+  }
+};
+}  // namespace df
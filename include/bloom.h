@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace df {
+/*
+split block bloom filter (parquet / impala layout): every key touches one
+32 byte block and sets one bit in each of its eight 32-bit words, so a probe
+is a single cache line and the eight lanes are independent and vectorize
+*/
+class BloomFilter {
+ private:
+  static constexpr size_t words_per_block{8};
+  static constexpr std::array<uint32_t, words_per_block> salts{
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+  using Block = std::array<uint32_t, words_per_block>;
+
+  std::vector<Block> blocks;
+
+ public:
+  // below this many keys the hash set itself stays cache resident
+  static constexpr size_t min_keys{4096};
+
+  explicit BloomFilter(size_t expected_keys, size_t bits_per_key = 10) {
+    size_t bits{expected_keys * bits_per_key};
+    size_t block_count{(bits + 255) / 256};
+    blocks.assign(std::max<size_t>(block_count, 1), Block{});
+  }
+
+  void insert(uint64_t h) {
+    Block& block{blocks[block_index(h)]};
+    uint32_t key{static_cast<uint32_t>(h)};
+    for (size_t i{}; i < words_per_block; ++i) {
+      block[i] |= uint32_t{1} << ((key * salts[i]) >> 27);
+    }
+  }
+
+  bool might_contain(uint64_t h) const {
+    const Block& block{blocks[block_index(h)]};
+    uint32_t key{static_cast<uint32_t>(h)};
+    uint32_t hit{1};
+    for (size_t i{}; i < words_per_block; ++i) {
+      hit &= (block[i] >> ((key * salts[i]) >> 27)) & 1U;
+    }
+    return hit != 0;
+  }
+
+  // batch probe, writes 1 for possible members and 0 for definite misses
+  void might_contain(const uint64_t* hashes, size_t n, uint8_t* out) const {
+    for (size_t i{}; i < n; ++i) {
+      out[i] = static_cast<uint8_t>(might_contain(hashes[i]));
+    }
+  }
+
+  size_t size_bytes() const { return blocks.size() * sizeof(Block); }
+
+ private:
+  size_t block_index(uint64_t h) const {
+    // multiply-shift range reduction on the upper half of the hash
+    return static_cast<size_t>(((h >> 32) * blocks.size()) >> 32);
+  }
+};
+}  // namespace df
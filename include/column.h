@@ -6,12 +6,20 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
+#include "bitmap.h"
+#include "bloom.h"
+#include "hash.h"
+#include "hash_table.h"
+#include "parallel.h"
+#include "reduce.h"
+#include "sketch.h"
 #include "utils.h"
 
 namespace df {
@@ -24,6 +32,10 @@ concept Storable = std::is_same_v<T, int64_t> || std::is_same_v<T, double> ||
 template <Storable T>
 class Column {
   friend class DataFrame;
+  friend class GroupBy;
+
+  template <typename... Cols>
+  friend class TypedFrame;
 
  public:
   using value_type = T;
@@ -41,6 +53,64 @@ class Column {
   }()};
   size_t null_count{};
 
+  /*
+  NOTE: zone maps, min / max / null count per block of zone_rows rows.
+  append keeps the zones current, any other mutable access marks the
+  touched blocks dirty and dirty or missing zones are rebuilt on the next
+  query. the rebuild runs under cache_lock, so concurrent const readers
+  are safe, friends write rows only through members that invalidate
+  */
+  struct Zone {
+    T min{};
+    T max{};
+    size_t nulls{};
+    bool has_values{};
+    bool dirty{true};
+
+    void add(const T& value) {
+      if (utils::is_null(value)) {
+        ++nulls;
+      } else if (!has_values) {
+        min = value;
+        max = value;
+        has_values = true;
+      } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  };
+
+  static constexpr size_t zone_rows{size_t{1} << 16};
+  mutable std::vector<Zone> zones;
+
+  /*
+  NOTE: optional bitmap index, one compressed row bitmap per distinct value.
+  append extends it in place, any other mutable access drops it and an
+  indexed column rebuilds it on the next query, under the same lock as the
+  zone maps. gathered copies (sort_by, take, slice, joins) stay indexed, and
+  build their own index on first use
+  */
+  bool indexed{};
+  mutable std::optional<BitmapIndex<T>> index;
+
+  // ids from the global string pool, set by DataFrame::intern
+  bool interned{};
+
+  // copies get their own lock, it only guards this column's lazy caches
+  struct CacheLock {
+    std::mutex mutex;
+
+    CacheLock() = default;
+    CacheLock(const CacheLock&) {}
+    CacheLock& operator=(const CacheLock&) { return *this; }
+  };
+  mutable CacheLock cache_lock;
+
+  // takes values whose null count the caller already has
+  Column(std::vector<T>&& d, size_t nulls)
+      : data(std::move(d)), null_count(nulls) {}
+
  public:
   Column() = default;
   Column(size_t size_reserve) { data.reserve(size_reserve); }
@@ -56,6 +126,12 @@ class Column {
     }
   }
 
+  Column(std::vector<T>&& d) : data(std::move(d)) {
+    for (const auto& x : data) {
+      null_count += utils::is_null(x);
+    }
+  }
+
   size_t get_null_count() const { return null_count; }
 
   size_t nrows() const { return data.size(); }
@@ -65,15 +141,42 @@ class Column {
   void clear() {
     data.clear();
     null_count = 0;
+    zones.clear();
+    index.reset();
   }
 
   void append(T value) {
     if (utils::is_null(value)) {
       ++null_count;
     }
+
+    // a zone that is current, or starts with this row, stays current
+    size_t block{data.size() / zone_rows};
+    if (block < zones.size() && !zones[block].dirty) {
+      zones[block].add(value);
+    } else if (block == zones.size() && data.size() % zone_rows == 0) {
+      zones.emplace_back().dirty = false;
+      zones.back().add(value);
+    }
+
+    if (index) {
+      index->add(data.size(), value);
+    }
+
     data.emplace_back(std::move(value));
   }
 
+  // moves the rows of other onto the end, other is left empty
+  void extend(Column<T>&& other) {
+    zones.resize(std::min(zones.size(), data.size() / zone_rows));
+    index.reset();
+
+    data.insert(data.end(), std::make_move_iterator(other.data.begin()),
+                std::make_move_iterator(other.data.end()));
+    null_count += other.null_count;
+    other.clear();
+  }
+
   ColumnType get_type() const { return type; }
 
   void describe() const {
@@ -179,6 +282,157 @@ class Column {
     }
   }
 
+  // =========================
+  // hashing methods
+  // =========================
+
+  void hash_into(std::vector<uint64_t>& hashes) const {
+    hashes.resize(data.size());
+    hash::hash_values(data.data(), data.size(), hashes.data());
+  }
+
+  void combine_hash_into(std::vector<uint64_t>& hashes) const {
+    if (hashes.size() != data.size()) {
+      throw std::invalid_argument("hash vector length does not match column");
+    }
+
+    hash::combine_values(data.data(), data.size(), hashes.data());
+  }
+
+  // =========================
+  // selection methods
+  // =========================
+
+  // row indices whose value is in values, nulls never match
+  std::vector<size_t> isin(const std::vector<T>& values) const {
+    if (indexed) {
+      return current_index().any_of(values).to_selection();
+    }
+
+    using Key = std::conditional_t<std::is_same_v<T, std::string>,
+                                   std::string_view, T>;
+
+    FlatHashSet<Key> set{values.size()};
+    for (const auto& value : values) {
+      if (!utils::is_null(value)) {
+        set.insert(Key{value});
+      }
+    }
+
+    std::vector<size_t> selection{};
+    if (set.empty()) {
+      return selection;
+    }
+
+    std::vector<uint64_t> hashes{};
+    hash_into(hashes);
+
+    // once the set outgrows cache, reject most misses through a bloom pass
+    std::vector<uint8_t> candidates(data.size(), 1);
+    if (set.size() > BloomFilter::min_keys) {
+      BloomFilter bloom{set.size()};
+      for (const auto& value : values) {
+        if (!utils::is_null(value)) {
+          bloom.insert(hash::hash_value(value));
+        }
+      }
+      bloom.might_contain(hashes.data(), hashes.size(), candidates.data());
+    }
+
+    for (size_t i{}; i < data.size(); ++i) {
+      if (candidates[i] && !utils::is_null(data[i]) &&
+          set.contains(Key{data[i]}, hashes[i])) {
+        selection.push_back(i);
+      }
+    }
+
+    return selection;
+  }
+
+  void build_index() {
+    indexed = true;
+    current_index();
+  }
+
+  void drop_index() {
+    indexed = false;
+    index.reset();
+  }
+
+  // indexed, but the index is only built by the first query that needs it
+  void defer_index() {
+    indexed = true;
+    index.reset();
+  }
+
+  bool is_interned() const { return interned; }
+
+  // a column built from rows of source keeps its index and interned flags
+  void inherit(const Column<T>& source) {
+    if (source.indexed) {
+      defer_index();
+    }
+    interned = source.interned;
+  }
+
+  bool has_index() const { return indexed; }
+
+  /*
+  rows whose value is in values as a bitmap, so several predicates combine
+  with & and | before a single to_selection. read straight from the index
+  when one is built, otherwise a scan through isin
+  */
+  RoaringBitmap rows_in(const std::vector<T>& values) const {
+    if (indexed) {
+      return current_index().any_of(values);
+    }
+    return RoaringBitmap::from_selection(isin(values));
+  }
+
+  /*
+  row indices with lo <= value <= hi, nulls never match. blocks whose zone
+  lies outside the range are skipped and null free blocks inside it are
+  taken whole, only blocks straddling a bound are scanned
+  */
+  std::vector<size_t> between(const T& lo, const T& hi) const {
+    std::vector<size_t> selection{};
+    if (hi < lo) {
+      return selection;
+    }
+
+    const std::vector<Zone>& map{current_zones()};
+    const size_t chunks{parallel::chunk_count(map.size(), 1)};
+    std::vector<std::vector<size_t>> parts(chunks);
+
+    parallel::for_chunks(
+        map.size(), 1, [&](size_t chunk, size_t begin, size_t end) {
+          for (size_t b{begin}; b < end; ++b) {
+            const Zone& zone{map[b]};
+            const size_t first{b * zone_rows};
+            const size_t last{std::min(data.size(), first + zone_rows)};
+
+            if (!zone.has_values || zone.max < lo || hi < zone.min) {
+              continue;
+            }
+
+            std::vector<size_t>& part{parts[chunk]};
+            bool inside{zone.nulls == 0 && !(zone.min < lo) &&
+                        !(hi < zone.max)};
+            for (size_t i{first}; i < last; ++i) {
+              if (inside || (!utils::is_null(data[i]) && !(data[i] < lo) &&
+                             !(hi < data[i]))) {
+                part.push_back(i);
+              }
+            }
+          }
+        });
+
+    for (const auto& part : parts) {
+      selection.insert(selection.end(), part.begin(), part.end());
+    }
+    return selection;
+  }
+
   // =========================
   // statistical methods
   // =========================
@@ -188,23 +442,19 @@ class Column {
       throw std::invalid_argument("cannot get maximum of empty column");
     }
 
-    size_t start{0};
-    while (start < data.size() && utils::is_null(data[start])) {
-      ++start;
+    // combined from the zone maps, only dirty blocks are rescanned
+    const Zone* best{nullptr};
+    for (const auto& zone : current_zones()) {
+      if (zone.has_values && (best == nullptr || best->max < zone.max)) {
+        best = &zone;
+      }
     }
 
-    if (start == data.size()) {
+    if (best == nullptr) {
       throw std::invalid_argument("all values are null");
     }
 
-    T max{data[start]};
-    for (size_t i{start + 1}; i < data.size(); ++i) {
-      if (!utils::is_null(data[i]) && data[i] > max) {  // disregard null values
-        max = data[i];
-      }
-    }
-
-    return max;
+    return best->max;
   }
 
   T minimum() const {
@@ -212,23 +462,18 @@ class Column {
       throw std::invalid_argument("cannot get minimum of empty column");
     }
 
-    size_t start{0};
-    while (start < data.size() && utils::is_null(data[start])) {
-      ++start;
+    const Zone* best{nullptr};
+    for (const auto& zone : current_zones()) {
+      if (zone.has_values && (best == nullptr || zone.min < best->min)) {
+        best = &zone;
+      }
     }
 
-    if (start == data.size()) {
+    if (best == nullptr) {
       throw std::invalid_argument("all values are null");
     }
 
-    T min{data[start]};
-    for (size_t i{start + 1}; i < data.size(); ++i) {
-      if (!utils::is_null(data[i]) && data[i] < min) {  // disregard null values
-        min = data[i];
-      }
-    }
-
-    return min;
+    return best->min;
   }
 
   std::vector<T> mode() const {
@@ -236,73 +481,59 @@ class Column {
       throw std::invalid_argument("cannot get mode of empty column");
     }
 
-    std::vector<T> modes{};
-    std::unordered_map<T, size_t> frequency{};
-    for (size_t i{0}; i < data.size(); ++i) {
-      if (!utils::is_null<T>(data[i])) {
-        ++frequency[data[i]];
-      }
-    }
-
-    if (frequency.empty()) {
+    std::vector<std::pair<T, size_t>> counts{count_values()};
+    if (counts.empty()) {
       throw std::invalid_argument("all values are nulls, cannot compute mode");
     }
 
     size_t max_frequency{2};  // skips count of 1
-    for (const auto& [value, count] : frequency) {
-      if (count > max_frequency) {
-        max_frequency = count;
+    for (const auto& [_, count] : counts) {
+      max_frequency = std::max(max_frequency, count);
+    }
 
-        modes.clear();
-        modes.push_back(value);
-      } else if (count == max_frequency) {
-        modes.push_back(value);
+    std::vector<T> modes{};
+    for (auto& [value, count] : counts) {
+      if (count == max_frequency) {
+        modes.push_back(std::move(value));
       }
     }
 
     return modes;
   }
 
-  double percentile(double p = 0.0) const {
-    if (data.empty()) {
-      throw std::invalid_argument("cannot get percentile of empty column");
-    }
+  // distinct non-null values with their counts, most frequent first
+  std::vector<std::pair<T, size_t>> value_counts() const {
+    std::vector<std::pair<T, size_t>> counts{count_values()};
+    std::ranges::sort(counts, [](const auto& a, const auto& b) {
+      if (a.second != b.second) {
+        return a.second > b.second;
+      }
+      return a.first < b.first;
+    });
+    return counts;
+  }
 
-    size_t non_null{data.size() - null_count};
-    if (non_null == 0) {
-      throw std::invalid_argument("cannot get percentile: no non-null values");
+  // distinct non-null values in ascending order
+  std::vector<T> unique() const {
+    std::vector<std::pair<T, size_t>> counts{count_values()};
+
+    std::vector<T> values{};
+    values.reserve(counts.size());
+    for (auto& [value, _] : counts) {
+      values.push_back(std::move(value));
     }
+    return values;
+  }
 
+  size_t nunique() const { return count_values().size(); }
+
+  double percentile(double p = 0.0) const {
     if (p < 0.0 || p > 1.0) {
       throw std::invalid_argument("percentile must be between 0 and 1");
     }
 
     if constexpr (std::is_arithmetic_v<T>) {
-      std::vector<T> copy{};
-      copy.reserve(data.size() - null_count);
-      for (const auto& value : data) {
-        if (!utils::is_null(value)) {
-          copy.push_back(value);
-        }
-      }
-
-      if (copy.size() == 1) {
-        return static_cast<double>(copy[0]);
-      }
-
-      std::sort(copy.begin(), copy.end());
-
-      double index{p * (copy.size() - 1)};
-      size_t lower{static_cast<size_t>(std::floor(index))};
-      size_t upper{static_cast<size_t>(std::ceil(index))};
-
-      if (lower == upper) {
-        return static_cast<double>(copy[lower]);
-      }
-
-      double fraction{index - lower};
-      return static_cast<double>(copy[lower]) * (1 - fraction) +
-             static_cast<double>(copy[upper]) * fraction;
+      return interpolate(sorted_values(), p);
     } else {
       throw std::invalid_argument("column is not numeric type");
     }
@@ -318,18 +549,11 @@ class Column {
       throw std::invalid_argument("cannot get median: no non-null values");
     }
 
-    double sum{};
     if constexpr (std::is_arithmetic_v<T>) {
-      for (size_t i{0}; i < data.size(); ++i) {
-        if (!utils::is_null(data[i])) {
-          sum += data[i];
-        }
-      }
+      return reduce::sum(data.data(), data.size()).result();
     } else {
       throw std::invalid_argument("column is not numeric type");
     }
-
-    return sum;
   }
 
   double median() const {
@@ -404,16 +628,177 @@ class Column {
 
     if constexpr (std::is_arithmetic_v<T>) {
       double mu{mean()};
-      for (size_t i{0}; i < data.size(); ++i) {
-        if (!utils::is_null(data[i])) {
-          summation += (data[i] - mu) * (data[i] - mu);
+      summation =
+          reduce::squared_deviations(data.data(), data.size(), mu).result();
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+
+    return summation / (non_null - 1);
+  }
+
+  // =========================
+  // binning methods
+  // =========================
+
+  // bins are [edges[i], edges[i + 1]), the last one closed on the right
+  std::vector<double> bin_edges(size_t bins) const {
+    if (bins == 0) {
+      throw std::invalid_argument("number of bins must be positive");
+    }
+
+    if constexpr (std::is_arithmetic_v<T>) {
+      double low{static_cast<double>(minimum())};
+      double high{static_cast<double>(maximum())};
+      if (low == high) {  // widen so a constant column still has a range
+        low -= 0.5;
+        high += 0.5;
+      }
+
+      std::vector<double> edges(bins + 1);
+      for (size_t i{}; i <= bins; ++i) {
+        edges[i] = low + (high - low) * static_cast<double>(i) / bins;
+      }
+      edges.back() = high;
+      return edges;
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+  }
+
+  std::vector<size_t> histogram(size_t bins) const {
+    return histogram(bin_edges(bins));
+  }
+
+  std::vector<size_t> histogram(const std::vector<double>& edges) const {
+    validate_edges(edges);
+
+    if constexpr (std::is_arithmetic_v<T>) {
+      const size_t bins{edges.size() - 1};
+      const size_t chunks{parallel::chunk_count(data.size(), parallel_chunk)};
+
+      // per chunk histograms, merged once all chunks finish
+      std::vector<std::vector<size_t>> partials(chunks,
+                                                std::vector<size_t>(bins, 0));
+      parallel::for_chunks(
+          data.size(), parallel_chunk,
+          [&](size_t chunk, size_t begin, size_t end) {
+            std::vector<size_t>& counts{partials[chunk]};
+            for (size_t i{begin}; i < end; ++i) {
+              int64_t bin{bin_index(edges, data[i])};
+              if (bin >= 0) {
+                ++counts[bin];
+              }
+            }
+          });
+
+      std::vector<size_t> counts(bins, 0);
+      for (const auto& partial : partials) {
+        for (size_t b{}; b < bins; ++b) {
+          counts[b] += partial[b];
         }
       }
+      return counts;
     } else {
       throw std::invalid_argument("column is not numeric type");
     }
+  }
 
-    return summation / (non_null - 1);
+  // bin code per row, null for null values and values outside the edges
+  Column<int64_t> cut(const std::vector<double>& edges) const {
+    validate_edges(edges);
+
+    if constexpr (std::is_arithmetic_v<T>) {
+      std::vector<int64_t> codes(data.size());
+      parallel::for_chunks(data.size(), parallel_chunk,
+                           [&](size_t, size_t begin, size_t end) {
+                             for (size_t i{begin}; i < end; ++i) {
+                               int64_t bin{bin_index(edges, data[i])};
+                               codes[i] = bin >= 0 ? bin
+                                                   : utils::get_null<int64_t>();
+                             }
+                           });
+      return Column<int64_t>(std::move(codes));
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+  }
+
+  Column<int64_t> cut(size_t bins) const { return cut(bin_edges(bins)); }
+
+  // equal population bins, repeated quantile edges are collapsed
+  Column<int64_t> qcut(size_t quantiles) const {
+    if (quantiles == 0) {
+      throw std::invalid_argument("number of quantiles must be positive");
+    }
+
+    std::vector<double> edges{};
+    if constexpr (std::is_arithmetic_v<T>) {
+      // one sort serves every edge
+      const std::vector<T> sorted{sorted_values()};
+      edges.reserve(quantiles + 1);
+      for (size_t i{}; i <= quantiles; ++i) {
+        double edge{interpolate(sorted, static_cast<double>(i) / quantiles)};
+        if (edges.empty() || edge > edges.back()) {
+          edges.push_back(edge);
+        }
+      }
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+
+    if (edges.size() < 2) {
+      edges.push_back(edges.front() + 1.0);
+    }
+    return cut(edges);
+  }
+
+  // =========================
+  // approximate methods
+  // =========================
+
+  HyperLogLog distinct_sketch(uint8_t precision = 14) const {
+    HyperLogLog hll{precision};
+    std::vector<uint64_t> hashes{};
+    hash_into(hashes);
+    for (size_t i{}; i < data.size(); ++i) {
+      if (!utils::is_null(data[i])) {
+        hll.add_hash(hashes[i]);
+      }
+    }
+    return hll;
+  }
+
+  TDigest quantile_sketch(double compression = 100.0) const {
+    if constexpr (std::is_arithmetic_v<T>) {
+      TDigest digest{compression};
+      for (const auto& value : data) {
+        if (!utils::is_null(value)) {
+          digest.add(static_cast<double>(value));
+        }
+      }
+      digest.compress();
+      return digest;
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+  }
+
+  size_t approx_nunique(uint8_t precision = 14) const {
+    HyperLogLog hll{distinct_sketch(precision)};
+    return static_cast<size_t>(std::llround(hll.estimate()));
+  }
+
+  double approx_percentile(double p, double compression = 100.0) const {
+    if (data.empty()) {
+      throw std::invalid_argument("cannot get percentile of empty column");
+    }
+
+    if (data.size() == null_count) {
+      throw std::invalid_argument("cannot get percentile: no non-null values");
+    }
+
+    return quantile_sketch(compression).quantile(p);
   }
 
   // =========================
@@ -429,6 +814,8 @@ class Column {
       throw std::out_of_range("column index out of range");
     }
 
+    invalidate(i / zone_rows);
+    index.reset();
     return data[i];
   }
 
@@ -450,27 +837,282 @@ class Column {
     }
 
     data.erase(data.begin() + index);
+    zones.resize(std::min(zones.size(), index / zone_rows));
+    this->index.reset();
+  }
+
+  // keeps the rows not flagged in remove, in order
+  void compact(const std::vector<bool>& remove) {
+    size_t write{};
+    for (size_t i{}; i < data.size(); ++i) {
+      if (remove[i]) {
+        null_count -= utils::is_null(data[i]);
+      } else {
+        if (write != i) {
+          data[write] = std::move(data[i]);
+        }
+        ++write;
+      }
+    }
+
+    data.resize(write);
+    zones.clear();
+    index.reset();
   }
 
   void reserve(size_t capacity) { data.reserve(capacity); }
-  void resize(size_t count) { data.resize(count); }
+  void resize(size_t count) {
+    data.resize(count);
+    zones.resize(std::min(zones.size(), count / zone_rows));
+    index.reset();
+  }
 
   using iterator = typename std::vector<T>::iterator;
   using const_iterator = typename std::vector<T>::const_iterator;
 
-  iterator begin() { return data.begin(); }
+  iterator begin() {
+    zones.clear();  // writes through iterators are not tracked
+    index.reset();
+    return data.begin();
+  }
   const_iterator begin() const { return data.begin(); }
   const_iterator cbegin() const noexcept { return data.cbegin(); }
-  iterator end() { return data.end(); }
+  iterator end() {
+    zones.clear();
+    index.reset();
+    return data.end();
+  }
   const_iterator end() const { return data.end(); }
   const_iterator cend() const noexcept { return data.cend(); }
 
-  T& front() { return data.front(); }
+  T& front() {
+    invalidate(0);
+    index.reset();
+    return data.front();
+  }
   const T& front() const { return data.front(); }
-  T& back() { return data.back(); }
+  T& back() {
+    invalidate((data.size() - 1) / zone_rows);
+    index.reset();
+    return data.back();
+  }
   const T& back() const { return data.back(); }
 
  private:
   void decrement_null() { --null_count; }
+
+  // non-null values in ascending order, for percentile and qcut
+  std::vector<T> sorted_values() const {
+    if (data.empty()) {
+      throw std::invalid_argument("cannot get percentile of empty column");
+    }
+
+    if (data.size() == null_count) {
+      throw std::invalid_argument("cannot get percentile: no non-null values");
+    }
+
+    std::vector<T> sorted{};
+    sorted.reserve(data.size() - null_count);
+    for (const auto& value : data) {
+      if (!utils::is_null(value)) {
+        sorted.push_back(value);
+      }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+
+  // linear interpolation between the two closest ranks
+  static double interpolate(const std::vector<T>& sorted, double p) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      double index{p * (sorted.size() - 1)};
+      size_t lower{static_cast<size_t>(std::floor(index))};
+      size_t upper{static_cast<size_t>(std::ceil(index))};
+
+      if (lower == upper) {
+        return static_cast<double>(sorted[lower]);
+      }
+
+      double fraction{index - lower};
+      return static_cast<double>(sorted[lower]) * (1 - fraction) +
+             static_cast<double>(sorted[upper]) * fraction;
+    } else {
+      throw std::invalid_argument("column is not numeric type");
+    }
+  }
+
+  void invalidate(size_t block) {
+    if (block < zones.size()) {
+      zones[block].dirty = true;
+    }
+  }
+
+  // zone for every block, rebuilding missing and dirty ones
+  const std::vector<Zone>& current_zones() const {
+    std::lock_guard lock{cache_lock.mutex};
+    const size_t blocks{(data.size() + zone_rows - 1) / zone_rows};
+    if (zones.size() != blocks) {
+      zones.resize(blocks);
+    }
+
+    for (size_t b{}; b < blocks; ++b) {
+      if (zones[b].dirty) {
+        Zone zone{};
+        zone.dirty = false;
+        const size_t last{std::min(data.size(), (b + 1) * zone_rows)};
+        for (size_t i{b * zone_rows}; i < last; ++i) {
+          zone.add(data[i]);
+        }
+        zones[b] = std::move(zone);
+      }
+    }
+    return zones;
+  }
+
+  const BitmapIndex<T>& current_index() const {
+    std::lock_guard lock{cache_lock.mutex};
+    if (!index) {
+      BitmapIndex<T> built{};
+      for (size_t i{}; i < data.size(); ++i) {
+        built.add(i, data[i]);
+      }
+      index = std::move(built);
+    }
+    return *index;
+  }
+
+  /*
+  NOTE: counting picks one of three paths
+  - int64 with a value range no wider than the column: direct indexed array
+  - mostly distinct sample: sort and run-length count, a hash table would
+    hold nearly every row and miss cache on each probe
+  - otherwise: flat hash table, string keys as views into data
+  results are always ascending by value
+  */
+  std::vector<std::pair<T, size_t>> count_values() const {
+    using Key = std::conditional_t<std::is_same_v<T, std::string>,
+                                   std::string_view, T>;
+
+    std::vector<std::pair<T, size_t>> counts{};
+    size_t non_null{data.size() - null_count};
+    if (non_null == 0) {
+      return counts;
+    }
+
+    if constexpr (std::is_same_v<T, int64_t>) {
+      T min{minimum()};
+      T max{maximum()};
+      uint64_t range{static_cast<uint64_t>(max) - static_cast<uint64_t>(min)};
+
+      if (range < std::max<uint64_t>(direct_count_limit, non_null)) {
+        std::vector<size_t> slots(range + 1, 0);
+        for (const auto& value : data) {
+          if (!utils::is_null(value)) {
+            ++slots[static_cast<uint64_t>(value) - static_cast<uint64_t>(min)];
+          }
+        }
+
+        for (size_t i{}; i < slots.size(); ++i) {
+          if (slots[i] > 0) {
+            counts.emplace_back(static_cast<T>(static_cast<uint64_t>(min) + i),
+                                slots[i]);
+          }
+        }
+        return counts;
+      }
+    }
+
+    if (non_null > cardinality_sample) {
+      FlatHashSet<Key> sample{cardinality_sample};
+      size_t seen{};
+      for (size_t i{}; i < data.size() && seen < cardinality_sample; ++i) {
+        if (!utils::is_null(data[i])) {
+          sample.insert(Key{data[i]});
+          ++seen;
+        }
+      }
+
+      if (sample.size() * 2 > seen) {
+        std::vector<Key> sorted{};
+        sorted.reserve(non_null);
+        for (const auto& value : data) {
+          if (!utils::is_null(value)) {
+            sorted.emplace_back(value);
+          }
+        }
+        std::ranges::sort(sorted);
+
+        for (size_t i{}; i < sorted.size();) {
+          size_t j{i + 1};
+          while (j < sorted.size() && sorted[j] == sorted[i]) {
+            ++j;
+          }
+          counts.emplace_back(T{sorted[i]}, j - i);
+          i = j;
+        }
+        return counts;
+      }
+    }
+
+    FlatHashMap<Key, size_t> table{};
+    for (const auto& value : data) {
+      if (!utils::is_null(value)) {
+        ++table[Key{value}];
+      }
+    }
+
+    counts.reserve(table.size());
+    table.for_each([&](const Key& key, size_t count) {
+      counts.emplace_back(T{key}, count);
+    });
+    std::ranges::sort(counts, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    return counts;
+  }
+
+  void validate_edges(const std::vector<double>& edges) const {
+    if (edges.size() < 2) {
+      throw std::invalid_argument("bin edges need at least two values");
+    }
+
+    for (size_t i{1}; i < edges.size(); ++i) {
+      if (!(edges[i] > edges[i - 1])) {
+        throw std::invalid_argument("bin edges must be strictly increasing");
+      }
+    }
+  }
+
+  /*
+  branch free upper bound over the edges, a fixed log2(edges) steps of
+  conditional moves, so the per row loop has no unpredictable branches
+  */
+  static int64_t bin_index(const std::vector<double>& edges, const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      const double x{static_cast<double>(value)};
+      if (utils::is_null(value) || !(x >= edges.front()) ||
+          !(x <= edges.back())) {
+        return -1;
+      }
+
+      const double* base{edges.data()};
+      size_t length{edges.size()};
+      while (length > 1) {
+        size_t half{length / 2};
+        base += (base[half] <= x) ? half : 0;
+        length -= half;
+      }
+
+      int64_t bin{base - edges.data()};
+      int64_t last{static_cast<int64_t>(edges.size()) - 2};
+      return std::min(bin, last);  // right edge closes the last bin
+    } else {
+      return -1;
+    }
+  }
+
+  static constexpr size_t parallel_chunk{1 << 16};
+  static constexpr uint64_t direct_count_limit{1 << 16};
+  static constexpr size_t cardinality_sample{1 << 16};
 };
 }  // namespace df
\ No newline at end of file
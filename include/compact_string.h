@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column.h"
+#include "hash.h"
+#include "hash_table.h"
+#include "sort.h"
+
+namespace df {
+/*
+NOTE: 16 byte string cell, the length and 12 bytes of data. the first 4
+data bytes are always the prefix, the other 8 hold either the rest of a
+string up to 12 bytes inline or the offset of the whole string in the
+owning column's buffer, read through memcpy. unused bytes are zero, so
+two cells of inline strings are equal exactly when their bytes are, and
+prefixes order like the strings whenever they differ
+*/
+class StringCell {
+ private:
+  uint32_t length{};
+  char data[12]{};
+
+ public:
+  static constexpr size_t inline_limit{12};
+
+  StringCell() = default;
+
+  StringCell(std::string_view s, std::vector<char>& buffer)
+      : length(static_cast<uint32_t>(s.size())) {
+    if (s.size() > UINT32_MAX) {
+      throw std::length_error("string too long for a compact cell");
+    }
+
+    if (is_inline()) {
+      std::memcpy(data, s.data(), s.size());
+    } else {
+      std::memcpy(data, s.data(), 4);
+      uint64_t offset{buffer.size()};
+      std::memcpy(data + 4, &offset, sizeof(offset));
+      buffer.insert(buffer.end(), s.begin(), s.end());
+    }
+  }
+
+  uint32_t size() const { return length; }
+  bool is_inline() const { return length <= inline_limit; }
+
+  std::string_view view(const std::vector<char>& buffer) const {
+    if (is_inline()) {
+      return {data, length};
+    }
+    return {buffer.data() + offset(), length};
+  }
+
+  // length and prefix as one word, compared before any heap access
+  uint64_t head() const {
+    uint64_t word{};
+    std::memcpy(&word, &length, sizeof(length));
+    std::memcpy(reinterpret_cast<char*>(&word) + sizeof(length), data, 4);
+    return word;
+  }
+
+  // prefix as a big endian integer, unsigned order matches string order
+  uint32_t prefix_key() const {
+    uint32_t key{};
+    for (size_t i{}; i < 4; ++i) {
+      key = (key << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return key;
+  }
+
+  bool equals(const StringCell& other, const std::vector<char>& buffer,
+              const std::vector<char>& other_buffer) const {
+    if (head() != other.head()) {
+      return false;
+    }
+    if (is_inline()) {
+      return std::memcmp(data + 4, other.data + 4, 8) == 0;
+    }
+    return std::memcmp(buffer.data() + offset(),
+                       other_buffer.data() + other.offset(), length) == 0;
+  }
+
+  bool less(const StringCell& other, const std::vector<char>& buffer,
+            const std::vector<char>& other_buffer) const {
+    uint32_t a{prefix_key()};
+    uint32_t b{other.prefix_key()};
+    if (a != b) {
+      return a < b;
+    }
+    if (length <= 4 && other.length <= 4) {
+      return length < other.length;
+    }
+    return view(buffer) < other.view(other_buffer);
+  }
+
+ private:
+  uint64_t offset() const {
+    uint64_t value{};
+    std::memcpy(&value, data + 4, sizeof(value));
+    return value;
+  }
+};
+
+static_assert(sizeof(StringCell) == 16);
+
+/*
+string column stored as compact cells over one contiguous buffer, an
+alternative to Column<std::string> for string keys. converts both ways and
+hashes like Column<std::string>, so row hashes stay comparable
+*/
+class CompactStringColumn {
+ private:
+  std::vector<StringCell> cells;
+  std::vector<char> buffer;
+
+ public:
+  CompactStringColumn() = default;
+
+  explicit CompactStringColumn(const Column<std::string>& column) {
+    reserve(column.nrows());
+    for (const auto& value : column) {
+      append(value);
+    }
+  }
+
+  explicit CompactStringColumn(const std::vector<std::string>& values) {
+    reserve(values.size());
+    for (const auto& value : values) {
+      append(value);
+    }
+  }
+
+  void reserve(size_t n) { cells.reserve(n); }
+
+  void append(std::string_view value) { cells.emplace_back(value, buffer); }
+
+  size_t nrows() const { return cells.size(); }
+  size_t buffer_bytes() const { return buffer.size(); }
+
+  std::string_view operator[](size_t i) const {
+    if (i >= cells.size()) {
+      throw std::out_of_range("index out of range");
+    }
+    return cells[i].view(buffer);
+  }
+
+  const std::vector<StringCell>& get_cells() const { return cells; }
+  const std::vector<char>& get_buffer() const { return buffer; }
+
+  Column<std::string> to_column() const {
+    std::vector<std::string> values{};
+    values.reserve(cells.size());
+    for (const auto& cell : cells) {
+      values.emplace_back(cell.view(buffer));
+    }
+    return Column<std::string>(std::move(values));
+  }
+
+  bool equal(size_t i, size_t j) const {
+    return cells[i].equals(cells[j], buffer, buffer);
+  }
+
+  bool less(size_t i, size_t j) const {
+    return cells[i].less(cells[j], buffer, buffer);
+  }
+
+  // =========================
+  // hashing methods
+  // =========================
+
+  void hash_into(std::vector<uint64_t>& hashes) const {
+    hashes.resize(cells.size());
+    for (size_t i{}; i < cells.size(); ++i) {
+      std::string_view value{cells[i].view(buffer)};
+      hashes[i] = hash::hash_bytes(value.data(), value.size());
+    }
+  }
+
+  // =========================
+  // selection and sorting methods
+  // =========================
+
+  // row indices equal to value, the cell head rejects nearly every miss
+  std::vector<size_t> equals(std::string_view value) const {
+    std::vector<char> probe_buffer{};
+    StringCell probe{value, probe_buffer};
+
+    std::vector<size_t> selection{};
+    for (size_t i{}; i < cells.size(); ++i) {
+      if (cells[i].equals(probe, buffer, probe_buffer)) {
+        selection.push_back(i);
+      }
+    }
+    return selection;
+  }
+
+  // stable, see sort::adaptive_sort
+  std::vector<size_t> argsort(bool ascending = true) const {
+    std::vector<size_t> indices(cells.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    if (ascending) {
+      sort::adaptive_sort(std::span<size_t>(indices),
+                          [&](size_t a, size_t b) { return less(a, b); });
+    } else {
+      sort::adaptive_sort(std::span<size_t>(indices),
+                          [&](size_t a, size_t b) { return less(b, a); });
+    }
+    return indices;
+  }
+
+  // first row of every distinct value, in row order
+  std::vector<size_t> distinct_rows() const {
+    std::vector<uint64_t> hashes{};
+    hash_into(hashes);
+
+    FlatHashMap<uint64_t, std::vector<size_t>, IdentityHash> seen{};
+    seen.reserve(cells.size());
+
+    std::vector<size_t> rows{};
+    for (size_t i{}; i < cells.size(); ++i) {
+      std::vector<size_t>& bucket{seen[hashes[i]]};
+      bool duplicate{std::ranges::any_of(
+          bucket, [&](size_t row) { return equal(row, i); })};
+      if (!duplicate) {
+        bucket.push_back(i);
+        rows.push_back(i);
+      }
+    }
+    return rows;
+  }
+};
+}  // namespace df
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column.h"
+#include "utils.h"
+
+namespace df {
+namespace csv {
+inline constexpr size_t min_chunk_bytes{size_t{1} << 20};
+
+inline std::string read_file(const std::string& path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file.is_open()) {
+    throw std::runtime_error("failed to open csv file: " + path);
+  }
+
+  file.seekg(0, std::ios::end);
+  std::streamsize size(file.tellg());
+  file.seekg(0, std::ios::beg);
+
+  std::string buffer(size, '\0');
+  file.read(buffer.data(), size);
+  return buffer;
+}
+
+/*
+splits the next field off line at pos, quoting and trimming the way
+utils::to_tokens does but without building a token vector. returns false
+once the line is exhausted
+*/
+inline bool next_field(std::string_view line, size_t& pos, char delimiter,
+                       std::string_view& field) {
+  if (pos > line.size()) {
+    return false;
+  }
+
+  size_t end{pos};
+  bool in_quotes{false};
+  for (; end < line.size(); ++end) {
+    if (line[end] == '"') {
+      in_quotes = !in_quotes;
+    } else if (line[end] == delimiter && !in_quotes) {
+      break;
+    }
+  }
+
+  field = utils::trim(line.substr(pos, end - pos));
+  if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+    field.remove_prefix(1);
+    field.remove_suffix(1);
+  }
+  pos = end + 1;
+  return true;
+}
+
+// unparseable numbers become null, as in DataFrame::from_csv
+template <Storable T>
+inline T parse_field(std::string_view field) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(field);
+  } else {
+    return utils::parse<T>(field);
+  }
+}
+
+// offsets cutting text into about chunks pieces, each ending after a newline
+inline std::vector<size_t> line_bounds(std::string_view text, size_t chunks) {
+  std::vector<size_t> bounds{0};
+  for (size_t c{1}; c < chunks; ++c) {
+    size_t target{std::max(bounds.back(), text.size() * c / chunks)};
+    size_t newline{text.find('\n', target)};
+    if (newline == std::string_view::npos) {
+      break;
+    }
+    bounds.push_back(newline + 1);
+  }
+  bounds.push_back(text.size());
+  return bounds;
+}
+}  // namespace csv
+}  // namespace df
@@ -3,27 +3,39 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "column.h"
+#include "record.h"
+#include "rolling.h"
 #include "row.h"
+#include "sort.h"
 
 namespace df {
 using ColumnVariant =
     std::variant<Column<int64_t>, Column<double>, Column<std::string>>;
 
+class GroupBy;
+
+enum class NullHandling { Pairwise, CompleteRows };
+
 class DataFrame {
+  friend class GroupBy;
+
  private:
   std::unordered_map<std::string, ColumnVariant> columns;
   std::vector<std::string> column_info;
 
-  size_t rows;
-  size_t cols;
+  size_t rows{};
+  size_t cols{};
 
  public:
   // =====================================
@@ -56,6 +68,13 @@ class DataFrame {
   std::vector<std::byte> to_bytes() const;
   void to_binary(const std::string& path) const;
 
+  template <typename S, FieldOf<S>... Fields>
+  static DataFrame from_structs(std::span<const S> records,
+                                const Fields&... fields);
+
+  template <typename S, FieldOf<S>... Fields>
+  std::vector<S> to_structs(const Fields&... fields) const;
+
   // =====================================
   // size methods
   // =====================================
@@ -75,7 +94,7 @@ class DataFrame {
   bool has_column(const std::string& column_name) const;
 
   template <Storable T>
-  void add_column(const std::string& column_name, const std::vector<T>& data);
+  void add_column(const std::string& column_name, std::vector<T> data);
 
   template <Storable T>
   const Column<T>* get_column(const std::string& column_name) const;
@@ -88,6 +107,12 @@ class DataFrame {
 
   void drop_column(const std::string& column_name);
 
+  DataFrame& intern(const std::string& column_name);
+  DataFrame& resolve(const std::string& column_name);
+
+  DataFrame& build_index(const std::string& column_name);
+  DataFrame& drop_index(const std::string& column_name);
+
   // =====================================
   // row methods
   // =====================================
@@ -130,10 +155,23 @@ class DataFrame {
   // selection and sorting methods
   // =====================================
 
-  DataFrame& sort_by(const std::string& column_name, bool ascending = true);
+  DataFrame& sort_by(const std::string& column_name, bool ascending = true,
+                     SortMethod method = SortMethod::Auto);
 
   DataFrame select(const std::vector<std::string>& subset) const;
   DataFrame slice(size_t start = 0, size_t end = 0) const;
+  DataFrame take(const std::vector<size_t>& indices) const;
+
+  template <Storable T>
+  DataFrame between(const std::string& column_name, const T& lo,
+                    const T& hi) const;
+
+  template <Storable T>
+  RoaringBitmap rows_in(const std::string& column_name,
+                        const std::vector<T>& values) const;
+
+  static DataFrame merge_sorted(const std::vector<DataFrame>& frames,
+                                const std::string& key);
 
   // =====================================
   // join methods
@@ -149,6 +187,65 @@ class DataFrame {
                              const std::vector<std::string>& on);
   static DataFrame anti_join(const DataFrame& df, const DataFrame& other,
                              const std::vector<std::string>& on);
+  static DataFrame semi_join(const DataFrame& df, const DataFrame& other,
+                             const std::vector<std::string>& on);
+
+  static DataFrame band_join(const DataFrame& left, const DataFrame& right,
+                             const std::string& left_on,
+                             const std::string& right_on, double before,
+                             double after,
+                             const std::vector<std::string>& by = {});
+  static DataFrame interval_join(const DataFrame& left, const DataFrame& right,
+                                 const std::string& start,
+                                 const std::string& end,
+                                 const std::string& right_on,
+                                 const std::vector<std::string>& by = {});
+
+  // =====================================
+  // grouping methods
+  // =====================================
+
+  GroupBy groupby(const std::vector<std::string>& by) const;
+
+  // =====================================
+  // reshaping methods
+  // =====================================
+
+  DataFrame pivot(const std::string& index, const std::string& column,
+                  const std::string& values) const;
+  DataFrame melt(const std::vector<std::string>& id_vars,
+                 const std::vector<std::string>& value_vars = {},
+                 const std::string& var_name = "variable",
+                 const std::string& value_name = "value") const;
+
+  // =====================================
+  // window methods
+  // =====================================
+
+  DataFrame& row_number(const std::vector<std::string>& partition_by,
+                        const std::string& order_by, const std::string& output,
+                        bool ascending = true);
+  DataFrame& rank(const std::vector<std::string>& partition_by,
+                  const std::string& order_by, const std::string& output,
+                  bool ascending = true);
+  DataFrame& dense_rank(const std::vector<std::string>& partition_by,
+                        const std::string& order_by, const std::string& output,
+                        bool ascending = true);
+
+  DataFrame& lag(const std::string& column_name, size_t offset,
+                 const std::vector<std::string>& partition_by,
+                 const std::string& order_by, const std::string& output);
+  DataFrame& lead(const std::string& column_name, size_t offset,
+                  const std::vector<std::string>& partition_by,
+                  const std::string& order_by, const std::string& output);
+
+  DataFrame& first_value(const std::string& column_name,
+                         const std::vector<std::string>& partition_by,
+                         const std::string& order_by,
+                         const std::string& output);
+  DataFrame& last_value(const std::string& column_name,
+                        const std::vector<std::string>& partition_by,
+                        const std::string& order_by, const std::string& output);
 
   // =====================================
   // statistical methods
@@ -165,16 +262,43 @@ class DataFrame {
   template <Storable T>
   std::vector<T> mode(const std::string& column_name) const;
 
+  template <Storable T>
+  std::vector<std::pair<T, size_t>> value_counts(
+      const std::string& column_name) const;
+
+  template <Storable T>
+  std::vector<T> unique(const std::string& column_name) const;
+
+  size_t nunique(const std::string& column_name) const;
+
   double sum(const std::string& column_name) const;
   double median(const std::string& column_name) const;
   double mean(const std::string& column_name) const;
   double standard_deviation(const std::string& column_name) const;
   double variance(const std::string& column_name) const;
 
+  DataFrame cov(NullHandling nulls = NullHandling::Pairwise) const;
+  DataFrame corr(NullHandling nulls = NullHandling::Pairwise) const;
+
+  DataFrame& cut(const std::string& column_name,
+                 const std::vector<double>& edges, const std::string& output);
+  DataFrame& qcut(const std::string& column_name, size_t quantiles,
+                  const std::string& output);
+
   // =====================================
   // time-series methods
   // =====================================
 
+  DataFrame& rolling(const std::string& x, const std::string& y,
+                     RollingStat stat, size_t window, const std::string& output,
+                     const std::vector<std::string>& by = {},
+                     size_t min_periods = 2);
+  DataFrame& rolling(const std::string& x, const std::string& y,
+                     RollingStat stat, const std::string& time_column,
+                     int64_t duration, const std::string& output,
+                     const std::vector<std::string>& by = {},
+                     size_t min_periods = 2);
+
   // =====================================
   // display methods
   // =====================================
@@ -202,25 +326,64 @@ class DataFrame {
 
   void validate_subset(const std::vector<std::string>& subset) const;
 
-  static void combine_hash(size_t& row_hash, size_t value_hash);
+  static std::vector<uint64_t> compute_row_hashes(
+      const DataFrame& df, const std::vector<std::string>& on);
 
-  static size_t compute_row_hash(const DataFrame& df, size_t index,
-                                 const std::vector<std::string>& on);
+  static std::unordered_map<uint64_t, std::vector<size_t>> build_row_hash_map(
+      const std::vector<uint64_t>& row_hashes);
 
-  static std::unordered_map<size_t, std::vector<Row>> build_row_hash_map(
-      const DataFrame& df, const std::vector<std::string>& on);
+  static std::vector<size_t> bloom_row_hashes(
+      const std::vector<uint64_t>& probe, const std::vector<uint64_t>& build,
+      size_t keys);
+
+  static std::vector<size_t> probe_row_hashes(
+      const std::vector<uint64_t>& probe, const std::vector<uint64_t>& build);
+
+  static DataFrame gather_join(const DataFrame& left, const DataFrame& right,
+                               const std::vector<size_t>& left_rows,
+                               const std::vector<size_t>& right_rows,
+                               const std::vector<std::string>& skip);
 
-  static std::tuple < std::vector<std::string>, std::vector<std::string>,
-      std::unordered_map<std::string, ColumnVariant>> setup_join(
-          const DataFrame& left, const DataFrame& right,
-          const std::vector<std::string>& on, size_t size);
+  static DataFrame range_join(const DataFrame& left, const DataFrame& right,
+                              const std::string& lower,
+                              const std::string& upper,
+                              const std::string& right_on, double before,
+                              double after, const std::vector<std::string>& by);
 
   void print(size_t start, size_t end) const;
 
+  DataFrame covariance_matrix(NullHandling nulls, bool normalize) const;
+
+  std::vector<std::vector<size_t>> partition_rows(
+      const std::vector<std::string>& by) const;
+
+  const std::vector<double>& double_values(
+      const std::string& column_name) const;
+
+  std::vector<std::vector<size_t>> ordered_partitions(
+      const std::vector<std::string>& partition_by,
+      const std::string& order_by, bool ascending = true) const;
+
+  enum class Ranking { RowNumber, Rank, DenseRank };
+
+  DataFrame& ranking(const std::vector<std::string>& partition_by,
+                     const std::string& order_by, const std::string& output,
+                     bool ascending, Ranking method);
+
+  DataFrame& shift_within(const std::string& column_name, int64_t offset,
+                          const std::vector<std::string>& partition_by,
+                          const std::string& order_by,
+                          const std::string& output);
+
+  DataFrame& edge_value(const std::string& column_name, bool first,
+                        const std::vector<std::string>& partition_by,
+                        const std::string& order_by, const std::string& output);
+
   template <typename Func>
   double call_statistical_column_method(const std::string& column_name,
                                         Func func) const;
 };
 }  // namespace df
 
-#include "dataframe.inl"
\ No newline at end of file
+#include "dataframe.inl"
+#include "groupby.h"
\ No newline at end of file
@@ -35,28 +35,133 @@ DataFrame::DataFrame(std::vector<std::string> cn,
   }
 }
 
+// =====================================
+// i/o and serialization methods
+// =====================================
+
+/*
+NOTE: records are transposed a block at a time, so every field of a block
+is copied while its structs are still in cache. each field buffer is sized
+once and written in place, null counts are gathered on the way and the
+buffers are moved into fresh columns at the end
+*/
+template <typename S, FieldOf<S>... Fields>
+DataFrame DataFrame::from_structs(std::span<const S> records,
+                                  const Fields&... fields) {
+  static_assert(sizeof...(Fields) > 0, "no fields given");
+  constexpr size_t nfields{sizeof...(Fields)};
+  constexpr size_t block{1024};
+
+  DataFrame df{};
+  (df.column_info.push_back(fields.name), ...);
+  std::unordered_set<std::string> names(df.column_info.begin(),
+                                        df.column_info.end());
+  if (names.size() != nfields) {
+    throw std::invalid_argument("duplicate column names");
+  }
+
+  const size_t n{records.size()};
+  std::tuple buffers{std::vector<typename Fields::value_type>(n)...};
+
+  const size_t chunks{parallel::chunk_count(n, block)};
+  std::vector<size_t> nulls(chunks * nfields, 0);
+
+  parallel::for_chunks(n, block, [&](size_t chunk, size_t begin, size_t end) {
+    for (size_t lo{begin}; lo < end; lo += block) {
+      const size_t hi{std::min(end, lo + block)};
+      [&]<size_t... I>(std::index_sequence<I...>) {
+        auto transpose = [&]<typename F>(const F&, auto* out) {
+          size_t count{};
+          for (size_t i{lo}; i < hi; ++i) {
+            out[i] = F::get(records[i]);
+            count += utils::is_null(out[i]);
+          }
+          return count;
+        };
+        ((nulls[chunk * nfields + I] +=
+          transpose(fields, std::get<I>(buffers).data())),
+         ...);
+      }(std::index_sequence_for<Fields...>{});
+    }
+  });
+
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    auto total = [&](size_t f) {
+      size_t count{};
+      for (size_t c{}; c < chunks; ++c) {
+        count += nulls[c * nfields + f];
+      }
+      return count;
+    };
+    ((df.columns[fields.name] =
+          Column<typename Fields::value_type>{std::move(std::get<I>(buffers)),
+                                              total(I)}),
+     ...);
+  }(std::index_sequence_for<Fields...>{});
+
+  df.rows = n;
+  df.cols = nfields;
+  return df;
+}
+
+template <typename S, FieldOf<S>... Fields>
+std::vector<S> DataFrame::to_structs(const Fields&... fields) const {
+  static_assert(std::is_default_constructible_v<S>,
+                "record type must be default constructible");
+  constexpr size_t block{1024};
+
+  auto source = [&]<typename F>(const F& spec) {
+    const auto* column{get_column<typename F::value_type>(spec.name)};
+    if (column == nullptr) {
+      throw std::invalid_argument("no column '" + spec.name +
+                                  "' of the field type");
+    }
+    return column;
+  };
+  std::tuple sources{source(fields)...};
+
+  std::vector<S> records(rows);
+  parallel::for_chunks(rows, block, [&](size_t, size_t begin, size_t end) {
+    for (size_t lo{begin}; lo < end; lo += block) {
+      const size_t hi{std::min(end, lo + block)};
+      [&]<size_t... I>(std::index_sequence<I...>) {
+        auto transpose = [&]<typename F>(const F&, const auto* in) {
+          for (size_t i{lo}; i < hi; ++i) {
+            F::get(records[i]) = in[i];
+          }
+        };
+        (transpose(fields, std::get<I>(sources)->data.data()), ...);
+      }(std::index_sequence_for<Fields...>{});
+    }
+  });
+
+  return records;
+}
+
 // =====================================
 // column methods
 // =====================================
 
+// data is taken by value, so callers that pass an rvalue skip the copy
 template <Storable T>
 void DataFrame::add_column(const std::string& column_name,
-                           const std::vector<T>& data) {
+                           std::vector<T> data) {
   auto it{std::ranges::find(column_info, column_name)};
   if (it != column_info.end()) {
     throw std::runtime_error("column already exists in dataframe");
   }
 
+  const size_t length{data.size()};
   column_info.emplace_back(column_name);
-  columns[column_name] = Column<T>(std::forward<decltype(data)>(data));
+  columns[column_name] = Column<T>(std::move(data));
   ++cols;
 
-  if (rows == data.size()) {
+  if (rows == length) {
     return;
   }
 
-  if (rows < data.size()) {
-    rows = data.size();  // new max length column
+  if (rows < length) {
+    rows = length;  // new max length column
   }
 
   normalize_length();
@@ -146,6 +251,51 @@ DataFrame& DataFrame::fillna(const T& value, const std::vector<std::string>& sub
   return *this;
 }
 
+// =====================================
+// selection methods
+// =====================================
+
+// rows with lo <= value <= hi, blocks are pruned by the column zone maps
+template <Storable T>
+DataFrame DataFrame::between(const std::string& column_name, const T& lo,
+                             const T& hi) const {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  const auto* col_ptr{std::get_if<Column<T>>(&it->second)};
+  if (col_ptr == nullptr) {
+    throw std::invalid_argument("type mismatch, column '" + column_name +
+                                "' expects a different type");
+  }
+
+  return take(col_ptr->between(lo, hi));
+}
+
+/*
+rows whose value is in values, as a bitmap for combining predicates:
+  df.take((df.rows_in<std::string>("venue", {"A", "B"}) &
+           df.rows_in<std::string>("side", {"BUY"})).to_selection())
+indexed columns answer without scanning
+*/
+template <Storable T>
+RoaringBitmap DataFrame::rows_in(const std::string& column_name,
+                                 const std::vector<T>& values) const {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  const auto* col_ptr{std::get_if<Column<T>>(&it->second)};
+  if (col_ptr == nullptr) {
+    throw std::invalid_argument("type mismatch, column '" + column_name +
+                                "' expects a different type");
+  }
+
+  return col_ptr->rows_in(values);
+}
+
 // =====================================
 // statistical methods
 // =====================================
@@ -201,6 +351,41 @@ std::vector<T> DataFrame::mode(const std::string& column_name) const {
   return col_ptr->mode();
 }
 
+template <Storable T>
+std::vector<std::pair<T, size_t>> DataFrame::value_counts(
+    const std::string& column_name) const {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+  const auto& target{it->second};
+
+  const auto* col_ptr{std::get_if<Column<T>>(&target)};
+  if (col_ptr == nullptr) {
+    throw std::invalid_argument("type mismatch, column '" + column_name +
+                                "' expects a different type");
+  }
+
+  return col_ptr->value_counts();
+}
+
+template <Storable T>
+std::vector<T> DataFrame::unique(const std::string& column_name) const {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+  const auto& target{it->second};
+
+  const auto* col_ptr{std::get_if<Column<T>>(&target)};
+  if (col_ptr == nullptr) {
+    throw std::invalid_argument("type mismatch, column '" + column_name +
+                                "' expects a different type");
+  }
+
+  return col_ptr->unique();
+}
+
 // =====================================
 // helper methods
 // =====================================
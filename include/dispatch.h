@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "column.h"
+#include "parallel.h"
+#include "utils.h"
+
+namespace df {
+namespace dispatch {
+inline constexpr size_t npos{std::numeric_limits<size_t>::max()};
+
+/*
+NOTE: a kernel is a class template over the storable type with a static
+run(column, args...) that loops over rows itself. run<Kernel> resolves the
+column once through a table holding one entry per variant alternative,
+built at compile time, so type dispatch happens per column or per block
+of rows and never per cell
+*/
+template <template <typename> class Kernel, typename Variant, typename... Args>
+decltype(auto) run(Variant& column, Args&&... args) {
+  using Alternatives = std::remove_const_t<Variant>;
+  constexpr size_t count{std::variant_size_v<Alternatives>};
+
+  using First = std::variant_alternative_t<0, Alternatives>::value_type;
+  using Result = decltype(Kernel<First>::run(*std::get_if<0>(&column),
+                                             std::forward<Args>(args)...));
+  using Entry = Result (*)(Variant&, Args&&...);
+
+  static constexpr std::array<Entry, count> table{
+      []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<Entry, count>{
+            +[](Variant& v, Args&&... a) -> Result {
+              using T = std::variant_alternative_t<I, Alternatives>::value_type;
+              return Kernel<T>::run(*std::get_if<I>(&v),
+                                    std::forward<Args>(a)...);
+            }...};
+      }(std::make_index_sequence<count>{})};
+
+  if (column.valueless_by_exception()) {
+    throw std::bad_variant_access();
+  }
+  return table[column.index()](column, std::forward<Args>(args)...);
+}
+
+// =====================================
+// kernels
+// =====================================
+
+// rows copied into out as a new column, npos rows become null. the copy
+// keeps the index and interned flags of the column
+template <typename T>
+struct Gather {
+  template <typename Variant>
+  static void run(const Column<T>& column, const std::vector<size_t>& rows,
+                  Variant& out) {
+    std::vector<T> values(rows.size());
+    auto source{column.begin()};
+
+    parallel::for_chunks(
+        rows.size(), 1 << 16, [&](size_t, size_t begin, size_t end) {
+          for (size_t k{begin}; k < end; ++k) {
+            values[k] =
+                rows[k] == npos ? utils::get_null<T>() : source[rows[k]];
+          }
+        });
+
+    Column<T> gathered(std::move(values));
+    gathered.inherit(column);
+    out = std::move(gathered);
+  }
+};
+
+// adds one to counts[i] for every null row i
+template <typename T>
+struct CountNulls {
+  static void run(const Column<T>& column, std::vector<size_t>& counts) {
+    auto values{column.begin()};
+    for (size_t i{}; i < column.nrows(); ++i) {
+      counts[i] += utils::is_null(values[i]);
+    }
+  }
+};
+
+// text of consecutive cells, cell k spans [ends[k - 1], ends[k])
+struct Cells {
+  std::string text;
+  std::vector<size_t> ends;
+
+  void clear() {
+    text.clear();
+    ends.clear();
+  }
+
+  std::string_view operator[](size_t k) const {
+    size_t start{k == 0 ? 0 : ends[k - 1]};
+    return std::string_view{text}.substr(start, ends[k] - start);
+  }
+};
+
+struct CellFormat {
+  std::chars_format floats{std::chars_format::general};
+  int precision{17};
+  std::string_view null_text{};
+};
+
+// formats rows [begin, end), numbers as printf would with the given format
+template <typename T>
+struct FormatCells {
+  static void run(const Column<T>& column, size_t begin, size_t end,
+                  const CellFormat& format, Cells& cells) {
+    auto values{column.begin()};
+    char buffer[512];
+
+    for (size_t i{begin}; i < end; ++i) {
+      const T& value{values[i]};
+      if (utils::is_null(value)) {
+        cells.text += format.null_text;
+      } else if constexpr (std::is_same_v<T, std::string>) {
+        cells.text += value;
+      } else {
+        std::to_chars_result result{};
+        if constexpr (std::is_same_v<T, double>) {
+          result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                 format.floats, format.precision);
+        } else {
+          result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        }
+        if (result.ec == std::errc{}) {
+          cells.text.append(buffer, result.ptr);
+        } else {  // wider than the buffer, only huge fixed precisions
+          std::ostringstream stream{};
+          if (format.floats == std::chars_format::fixed) {
+            stream << std::fixed;
+          } else if (format.floats == std::chars_format::scientific) {
+            stream << std::scientific;
+          }
+          stream << std::setprecision(format.precision) << value;
+          cells.text += stream.str();
+        }
+      }
+      cells.ends.push_back(cells.text.size());
+    }
+  }
+};
+}  // namespace dispatch
+}  // namespace df
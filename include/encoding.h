@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "column.h"
+#include "parallel.h"
+#include "reduce.h"
+#include "utils.h"
+
+namespace df {
+enum class Encoding { BitPacked, Delta, RunLength };
+
+/*
+NOTE: compressed in memory form of an int64 column. bit packed stores every
+value minus its block minimum in as few bits as the block needs, delta packs
+the differences between neighbours the same way (sorted timestamps need a
+few bits a row) and run length keeps (value, run end) pairs. packed blocks
+hold reduce::block_size rows so one decoded block stays in cache, and keep
+their min, max and null count so scans can skip or shortcut whole blocks.
+sum() reduces the same reduce::block_size blocks through reduce_block and
+combine_pairwise, run length included, so it matches Column<int64_t>::sum
+bit for bit under every encoding
+*/
+class EncodedColumn {
+ private:
+  static constexpr size_t block_rows{reduce::block_size};
+  static constexpr size_t no_validity{std::numeric_limits<size_t>::max()};
+
+  struct Block {
+    int64_t first{};      // delta, value of the first row
+    uint64_t reference{}; // smallest packed quantity
+    int64_t min{};        // over non null rows
+    int64_t max{};
+    size_t word_offset{};
+    size_t validity_offset{no_validity};
+    uint32_t rows{};
+    uint32_t nulls{};
+    uint8_t width{};
+  };
+
+  Encoding encoding{Encoding::BitPacked};
+  size_t length{};
+  size_t null_count{};
+
+  std::vector<Block> blocks;
+  std::vector<uint64_t> words;
+  std::vector<uint64_t> validity;
+
+  std::vector<int64_t> run_values;
+  std::vector<size_t> run_ends;
+
+ public:
+  EncodedColumn() = default;
+
+  static EncodedColumn encode(const Column<int64_t>& column,
+                              Encoding encoding) {
+    EncodedColumn encoded{};
+    encoded.encoding = encoding;
+    encoded.length = column.nrows();
+    const int64_t* values{column.nrows() > 0 ? &*column.begin() : nullptr};
+
+    if (encoding == Encoding::RunLength) {
+      for (size_t i{}; i < encoded.length; ++i) {
+        encoded.null_count += utils::is_null(values[i]);
+        if (i == 0 || values[i] != values[i - 1]) {
+          encoded.run_values.push_back(values[i]);
+          encoded.run_ends.push_back(i + 1);
+        } else {
+          encoded.run_ends.back() = i + 1;
+        }
+      }
+      return encoded;
+    }
+
+    for (size_t begin{}; begin < encoded.length; begin += block_rows) {
+      size_t n{std::min(block_rows, encoded.length - begin)};
+      encoded.pack_block(values + begin, n);
+    }
+    return encoded;
+  }
+
+  // the smallest of the three encodings
+  static EncodedColumn encode(const Column<int64_t>& column) {
+    EncodedColumn best{encode(column, Encoding::BitPacked)};
+    for (Encoding encoding : {Encoding::Delta, Encoding::RunLength}) {
+      EncodedColumn candidate{encode(column, encoding)};
+      if (candidate.size_bytes() < best.size_bytes()) {
+        best = std::move(candidate);
+      }
+    }
+    return best;
+  }
+
+  Column<int64_t> decode() const {
+    std::vector<int64_t> values(length);
+    for_each_block([&](size_t begin, const int64_t* block, size_t n) {
+      std::copy_n(block, n, values.begin() + begin);
+    });
+    return Column<int64_t>(std::move(values));
+  }
+
+  Encoding get_encoding() const { return encoding; }
+  size_t nrows() const { return length; }
+  size_t get_null_count() const { return null_count; }
+
+  // bytes held by the encoded form
+  size_t size_bytes() const {
+    return blocks.size() * sizeof(Block) +
+           (words.size() + validity.size()) * sizeof(uint64_t) +
+           run_values.size() * sizeof(int64_t) +
+           run_ends.size() * sizeof(size_t);
+  }
+
+  /*
+  func(begin, values, n) for consecutive runs of decoded rows, at most one
+  block at a time through a reused buffer, nulls come back as the sentinel
+  */
+  template <typename Func>
+  void for_each_block(Func func) const {
+    std::vector<int64_t> buffer(block_rows);
+
+    if (encoding == Encoding::RunLength) {
+      size_t run{};
+      for (size_t begin{}; begin < length; begin += block_rows) {
+        size_t n{std::min(block_rows, length - begin)};
+        for (size_t i{}; i < n; ++i) {
+          while (run_ends[run] <= begin + i) {
+            ++run;
+          }
+          buffer[i] = run_values[run];
+        }
+        func(begin, buffer.data(), n);
+      }
+      return;
+    }
+
+    for (size_t b{}; b < blocks.size(); ++b) {
+      unpack_block(b, buffer.data());
+      func(b * block_rows, buffer.data(), blocks[b].rows);
+    }
+  }
+
+  // =========================
+  // aggregation methods
+  // =========================
+
+  size_t count() const { return length - null_count; }
+
+  double sum() const {
+    if (encoding == Encoding::RunLength) {
+      // runs expand a block at a time, so the partials match reduce::sum
+      std::vector<reduce::Accumulator> partials{};
+      partials.reserve((length + block_rows - 1) / block_rows);
+      for_each_block([&](size_t, const int64_t* values, size_t n) {
+        partials.push_back(
+            reduce::reduce_block(values, n, [](double x) { return x; }));
+      });
+      return reduce::combine_pairwise(partials).result();
+    }
+
+    std::vector<reduce::Accumulator> partials(blocks.size());
+    parallel::for_chunks(blocks.size(), reduce::blocks_per_chunk,
+                         [&](size_t, size_t begin, size_t end) {
+                           std::vector<int64_t> buffer(block_rows);
+                           for (size_t b{begin}; b < end; ++b) {
+                             unpack_block(b, buffer.data());
+                             partials[b] = reduce::reduce_block(
+                                 buffer.data(), blocks[b].rows,
+                                 [](double x) { return x; });
+                           }
+                         });
+    return reduce::combine_pairwise(partials).result();
+  }
+
+  // extremes come from block headers or runs without decoding
+  int64_t minimum() const { return extreme(true); }
+  int64_t maximum() const { return extreme(false); }
+
+  // =========================
+  // selection methods
+  // =========================
+
+  /*
+  rows with lo <= value <= hi. blocks outside the range are skipped and
+  null free blocks inside it are emitted whole, only straddling blocks are
+  decoded. run length selects whole runs
+  */
+  std::vector<size_t> between(int64_t lo, int64_t hi) const {
+    std::vector<size_t> selection{};
+    if (lo > hi) {
+      return selection;
+    }
+
+    if (encoding == Encoding::RunLength) {
+      size_t begin{};
+      for (size_t r{}; r < run_values.size(); ++r) {
+        int64_t value{run_values[r]};
+        if (!utils::is_null(value) && value >= lo && value <= hi) {
+          for (size_t i{begin}; i < run_ends[r]; ++i) {
+            selection.push_back(i);
+          }
+        }
+        begin = run_ends[r];
+      }
+      return selection;
+    }
+
+    const size_t chunks{parallel::chunk_count(blocks.size(), 1)};
+    std::vector<std::vector<size_t>> parts(chunks);
+    parallel::for_chunks(
+        blocks.size(), 1, [&](size_t chunk, size_t begin, size_t end) {
+          std::vector<int64_t> buffer(block_rows);
+          std::vector<size_t>& part{parts[chunk]};
+
+          for (size_t b{begin}; b < end; ++b) {
+            const Block& block{blocks[b]};
+            const size_t first_row{b * block_rows};
+            if (block.nulls == block.rows || block.max < lo ||
+                block.min > hi) {
+              continue;
+            }
+            if (block.nulls == 0 && block.min >= lo && block.max <= hi) {
+              for (size_t i{}; i < block.rows; ++i) {
+                part.push_back(first_row + i);
+              }
+              continue;
+            }
+
+            // branch free compaction
+            unpack_block(b, buffer.data());
+            size_t count{part.size()};
+            part.resize(count + block.rows);
+            for (size_t i{}; i < block.rows; ++i) {
+              int64_t value{buffer[i]};
+              part[count] = first_row + i;
+              count += !utils::is_null(value) & (value >= lo) & (value <= hi);
+            }
+            part.resize(count);
+          }
+        });
+
+    for (const auto& part : parts) {
+      selection.insert(selection.end(), part.begin(), part.end());
+    }
+    return selection;
+  }
+
+  std::vector<size_t> equals(int64_t value) const {
+    return between(value, value);
+  }
+
+ private:
+  static uint8_t bit_width(uint64_t x) {
+    uint8_t width{};
+    while (width < 64 && (x >> width) != 0) {
+      ++width;
+    }
+    return width;
+  }
+
+  void pack_block(const int64_t* values, size_t n) {
+    Block block{};
+    block.rows = static_cast<uint32_t>(n);
+    block.min = std::numeric_limits<int64_t>::max();
+    block.max = std::numeric_limits<int64_t>::min();
+
+    // nulls are stood in for by a neighbouring valid value so they pack
+    // into the block range, the validity bitmap restores them
+    std::array<uint64_t, block_rows> quantities{};
+    std::vector<int64_t> filled(values, values + n);
+    int64_t last_valid{};
+    bool seen_valid{};
+    for (size_t i{}; i < n; ++i) {
+      if (utils::is_null(values[i])) {
+        ++block.nulls;
+        continue;
+      }
+      block.min = std::min(block.min, values[i]);
+      block.max = std::max(block.max, values[i]);
+      if (!seen_valid) {
+        last_valid = values[i];
+        seen_valid = true;
+      }
+    }
+    for (size_t i{}; i < n; ++i) {
+      if (utils::is_null(filled[i])) {
+        filled[i] = last_valid;
+      } else {
+        last_valid = filled[i];
+      }
+    }
+
+    if (encoding == Encoding::Delta) {
+      block.first = filled[0];
+      int64_t smallest{std::numeric_limits<int64_t>::max()};
+      for (size_t i{1}; i < n; ++i) {
+        quantities[i] = static_cast<uint64_t>(filled[i]) -
+                        static_cast<uint64_t>(filled[i - 1]);
+        smallest = std::min(smallest, static_cast<int64_t>(quantities[i]));
+      }
+
+      // deltas are packed relative to the smallest signed delta, the first
+      // row is restored from first and packs as zero
+      block.reference = static_cast<uint64_t>(n > 1 ? smallest : 0);
+      quantities[0] = block.reference;
+      for (size_t i{}; i < n; ++i) {
+        quantities[i] -= block.reference;
+      }
+    } else {
+      block.reference = static_cast<uint64_t>(seen_valid ? block.min : 0);
+      for (size_t i{}; i < n; ++i) {
+        quantities[i] = static_cast<uint64_t>(filled[i]) - block.reference;
+      }
+    }
+
+    uint64_t widest{};
+    for (size_t i{}; i < n; ++i) {
+      widest |= quantities[i];
+    }
+    block.width = bit_width(widest);
+    if (!words.empty()) {
+      words.pop_back();  // previous slack word
+    }
+    block.word_offset = words.size();
+    words.resize(words.size() + (n * block.width + 63) / 64 + 1, 0);
+
+    uint64_t* out{words.data() + block.word_offset};
+    for (size_t i{}; i < n && block.width > 0; ++i) {
+      size_t bit{i * block.width};
+      size_t shift{bit & 63};
+      out[bit >> 6] |= quantities[i] << shift;
+      if (shift + block.width > 64) {
+        out[(bit >> 6) + 1] |= quantities[i] >> (64 - shift);
+      }
+    }
+
+    if (block.nulls > 0) {
+      block.validity_offset = validity.size();
+      validity.resize(validity.size() + (n + 63) / 64, 0);
+      for (size_t i{}; i < n; ++i) {
+        if (!utils::is_null(values[i])) {
+          validity[block.validity_offset + i / 64] |= uint64_t{1} << (i & 63);
+        }
+      }
+    }
+
+    null_count += block.nulls;
+    blocks.push_back(block);
+  }
+
+  void unpack_block(size_t b, int64_t* out) const {
+    const Block& block{blocks[b]};
+    const uint64_t* in{words.data() + block.word_offset};
+    const uint64_t mask{block.width == 64 ? ~uint64_t{0}
+                                          : (uint64_t{1} << block.width) - 1};
+
+    // two word reads per row without branches, the words vector keeps a
+    // slack word at the end so the second read never runs past it
+    for (size_t i{}; i < block.rows && block.width > 0; ++i) {
+      size_t bit{i * block.width};
+      size_t shift{bit & 63};
+      uint64_t low{in[bit >> 6] >> shift};
+      uint64_t high{(in[(bit >> 6) + 1] << 1) << (63 - shift)};
+      out[i] = static_cast<int64_t>(((low | high) & mask) + block.reference);
+    }
+    if (block.width == 0) {
+      std::fill(out, out + block.rows, static_cast<int64_t>(block.reference));
+    }
+
+    if (encoding == Encoding::Delta) {
+      out[0] = block.first;
+      for (size_t i{1}; i < block.rows; ++i) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(out[i - 1]) +
+                                      static_cast<uint64_t>(out[i]));
+      }
+    }
+
+    if (block.validity_offset != no_validity) {
+      const uint64_t* valid{validity.data() + block.validity_offset};
+      for (size_t i{}; i < block.rows; ++i) {
+        if (!((valid[i / 64] >> (i & 63)) & 1)) {
+          out[i] = utils::get_null<int64_t>();
+        }
+      }
+    }
+  }
+
+  int64_t extreme(bool smallest) const {
+    if (length == 0) {
+      throw std::invalid_argument("cannot get extreme of empty column");
+    }
+    if (count() == 0) {
+      throw std::invalid_argument("all values are null");
+    }
+
+    int64_t result{smallest ? std::numeric_limits<int64_t>::max()
+                            : std::numeric_limits<int64_t>::min()};
+    auto consider = [&](int64_t value) {
+      result = smallest ? std::min(result, value) : std::max(result, value);
+    };
+
+    if (encoding == Encoding::RunLength) {
+      for (const auto& value : run_values) {
+        if (!utils::is_null(value)) {
+          consider(value);
+        }
+      }
+      return result;
+    }
+
+    for (const auto& block : blocks) {
+      if (block.nulls < block.rows) {
+        consider(smallest ? block.min : block.max);
+      }
+    }
+    return result;
+  }
+};
+}  // namespace df
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "dataframe.h"
+#include "sketch.h"
+
+namespace df {
+enum class Aggregation { Count, Sum, Mean, Variance, Min, Max, ApproxNunique };
+
+enum class Transform { Count, Sum, Mean, Demean, ZScore, Rank };
+
+/*
+NOTE: holds a reference to the grouped frame, which must outlive it.
+groups are keyed on the row hashes shared with joins and drop_duplicates
+and numbered densely in order of first appearance
+*/
+class GroupBy {
+ private:
+  const DataFrame& df;
+  std::vector<std::string> keys;
+  std::vector<size_t> group_ids;
+  std::vector<size_t> first_rows;
+
+ public:
+  GroupBy(const DataFrame& d, std::vector<std::string> by);
+
+  size_t ngroups() const;
+  const std::vector<size_t>& get_group_ids() const;
+  const std::vector<size_t>& get_first_rows() const;
+
+  // =====================================
+  // aggregation methods
+  // =====================================
+
+  DataFrame agg(const std::string& column_name, Aggregation aggregation) const;
+  DataFrame approx_quantile(const std::string& column_name, double q,
+                            double compression = 100.0) const;
+
+  std::vector<HyperLogLog> distinct_sketches(const std::string& column_name,
+                                             uint8_t precision = 14) const;
+  std::vector<TDigest> quantile_sketches(const std::string& column_name,
+                                         double compression = 100.0) const;
+
+  // =====================================
+  // transform methods
+  // =====================================
+
+  std::vector<double> transform(const std::string& column_name,
+                                Transform op) const;
+
+ private:
+  DataFrame key_frame() const;
+
+  const ColumnVariant& value_column(const std::string& column_name) const;
+};
+}  // namespace df
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace df {
+namespace hash {
+/*
+NOTE: std::hash<int64_t> is the identity on libstdc++, which clusters
+sequential keys (order ids, timestamps) into neighbouring buckets.
+numerics go through an xxh3/moremur style avalanche built from shifts, xors
+and 64-bit multiplies only, so the column loops below auto-vectorize.
+strings go through a wyhash style streaming hash over 8 byte words
+*/
+inline constexpr uint64_t seed{0x9e3779b97f4a7c15};
+inline constexpr uint64_t secret_a{0xa0761d6478bd642f};
+inline constexpr uint64_t secret_b{0xe7037ed1a0b428db};
+
+inline uint64_t avalanche(uint64_t h) {
+  h ^= h >> 27;
+  h *= 0x3c79ac492ba7b653;
+  h ^= h >> 33;
+  h *= 0x1c69b3f74ac4ae35;
+  h ^= h >> 27;
+  return h;
+}
+
+inline uint64_t mum(uint64_t a, uint64_t b) {
+  __uint128_t product{static_cast<__uint128_t>(a) * b};
+  return static_cast<uint64_t>(product) ^
+         static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t read_u64(const char* p) {
+  uint64_t value{};
+  std::memcpy(&value, p, sizeof(uint64_t));
+  return value;
+}
+
+inline uint64_t hash_bytes(const char* p, size_t n, uint64_t s = seed) {
+  uint64_t state{s ^ mum(n ^ secret_a, secret_b)};
+
+  while (n >= 8) {
+    state = mum(read_u64(p) ^ secret_a, state ^ secret_b);
+    p += 8;
+    n -= 8;
+  }
+
+  if (n > 0) {
+    uint64_t tail{};
+    std::memcpy(&tail, p, n);  // never reads past the end
+    state = mum(tail ^ secret_b, state ^ secret_a);
+  }
+
+  return avalanche(state);
+}
+
+template <typename T>
+inline uint64_t hash_value(const T& value, uint64_t s = seed) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return avalanche(static_cast<uint64_t>(value) ^ s);
+  } else if constexpr (std::is_same_v<T, double>) {
+    // +0.0 and -0.0 compare equal, so they must hash equal
+    double normalized{value == 0.0 ? 0.0 : value};
+    uint64_t bits{};
+    std::memcpy(&bits, &normalized, sizeof(double));
+    return avalanche(bits ^ s);
+  } else {
+    std::string_view sv{value};
+    return hash_bytes(sv.data(), sv.size(), s);
+  }
+}
+
+inline uint64_t combine(uint64_t row_hash, uint64_t value_hash) {
+  return avalanche(row_hash ^ (value_hash + seed + (row_hash << 6) +
+                               (row_hash >> 2)));
+}
+
+/*
+column-at-a-time kernels, the first key column fills the row hashes and
+every further key column folds into them, so the column type is resolved
+once per column instead of once per cell
+*/
+template <typename T>
+inline void hash_values(const T* values, size_t n, uint64_t* out) {
+  for (size_t i{}; i < n; ++i) {
+    out[i] = hash_value<T>(values[i]);
+  }
+}
+
+template <typename T>
+inline void combine_values(const T* values, size_t n, uint64_t* hashes) {
+  for (size_t i{}; i < n; ++i) {
+    hashes[i] = combine(hashes[i], hash_value<T>(values[i]));
+  }
+}
+
+}  // namespace hash
+}  // namespace df
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "hash.h"
+
+namespace df {
+template <typename K>
+struct KeyHash {
+  uint64_t operator()(const K& key) const { return hash::hash_value(key); }
+};
+
+// for keys that are already row hashes from hash::combine
+struct IdentityHash {
+  uint64_t operator()(uint64_t key) const { return key; }
+};
+
+/*
+open addressing with linear probing over flat key / control arrays, no node
+allocations. string keys are meant to be std::string_view into storage that
+outlives the table
+*/
+template <typename K, typename Hash = KeyHash<K>>
+class FlatHashSet {
+ private:
+  std::vector<K> keys;
+  std::vector<uint8_t> occupied;
+  size_t count{};
+  size_t mask{};
+  Hash hasher{};
+
+ public:
+  FlatHashSet() { rehash(16); }
+  explicit FlatHashSet(size_t expected) { reserve(expected); }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  void reserve(size_t expected) {
+    // keep load factor at or below 0.5
+    size_t capacity{std::bit_ceil(std::max<size_t>(16, expected * 2))};
+    if (capacity > keys.size()) {
+      rehash(capacity);
+    }
+  }
+
+  bool insert(const K& key) { return insert(key, hasher(key)); }
+
+  bool insert(const K& key, uint64_t h) {
+    if ((count + 1) * 2 > keys.size()) {
+      rehash(keys.size() * 2);
+    }
+
+    size_t slot{h & mask};
+    while (occupied[slot]) {
+      if (keys[slot] == key) {
+        return false;
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    keys[slot] = key;
+    occupied[slot] = 1;
+    ++count;
+    return true;
+  }
+
+  bool contains(const K& key) const { return contains(key, hasher(key)); }
+
+  bool contains(const K& key, uint64_t h) const {
+    size_t slot{h & mask};
+    while (occupied[slot]) {
+      if (keys[slot] == key) {
+        return true;
+      }
+      slot = (slot + 1) & mask;
+    }
+    return false;
+  }
+
+ private:
+  void rehash(size_t capacity) {
+    std::vector<K> old_keys{std::move(keys)};
+    std::vector<uint8_t> old_occupied{std::move(occupied)};
+
+    keys.assign(capacity, K{});
+    occupied.assign(capacity, 0);
+    mask = capacity - 1;
+    count = 0;
+
+    for (size_t i{}; i < old_keys.size(); ++i) {
+      if (old_occupied[i]) {
+        insert(old_keys[i]);
+      }
+    }
+  }
+};
+
+template <typename K, typename V, typename Hash = KeyHash<K>>
+class FlatHashMap {
+ private:
+  std::vector<K> keys;
+  std::vector<V> values;
+  std::vector<uint8_t> occupied;
+  size_t count{};
+  size_t mask{};
+  Hash hasher{};
+
+ public:
+  FlatHashMap() { rehash(16); }
+  explicit FlatHashMap(size_t expected) { reserve(expected); }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  void reserve(size_t expected) {
+    size_t capacity{std::bit_ceil(std::max<size_t>(16, expected * 2))};
+    if (capacity > keys.size()) {
+      rehash(capacity);
+    }
+  }
+
+  // finds or default inserts
+  V& operator[](const K& key) {
+    if ((count + 1) * 2 > keys.size()) {
+      rehash(keys.size() * 2);
+    }
+
+    size_t slot{hasher(key) & mask};
+    while (occupied[slot]) {
+      if (keys[slot] == key) {
+        return values[slot];
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    keys[slot] = key;
+    values[slot] = V{};
+    occupied[slot] = 1;
+    ++count;
+    return values[slot];
+  }
+
+  const V* find(const K& key) const {
+    size_t slot{hasher(key) & mask};
+    while (occupied[slot]) {
+      if (keys[slot] == key) {
+        return &values[slot];
+      }
+      slot = (slot + 1) & mask;
+    }
+    return nullptr;
+  }
+
+  template <typename Func>
+  void for_each(Func func) const {
+    for (size_t i{}; i < keys.size(); ++i) {
+      if (occupied[i]) {
+        func(keys[i], values[i]);
+      }
+    }
+  }
+
+ private:
+  void rehash(size_t capacity) {
+    std::vector<K> old_keys{std::move(keys)};
+    std::vector<V> old_values{std::move(values)};
+    std::vector<uint8_t> old_occupied{std::move(occupied)};
+
+    keys.assign(capacity, K{});
+    values.assign(capacity, V{});
+    occupied.assign(capacity, 0);
+    mask = capacity - 1;
+    count = 0;
+
+    for (size_t i{}; i < old_keys.size(); ++i) {
+      if (old_occupied[i]) {
+        (*this)[old_keys[i]] = std::move(old_values[i]);
+      }
+    }
+  }
+};
+}  // namespace df
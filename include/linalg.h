@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "parallel.h"
+
+namespace df {
+namespace linalg {
+inline constexpr size_t tile{4};
+inline constexpr size_t row_block{1024};
+
+// four independent partial sums, fp adds cannot be reordered by the compiler
+inline double dot(const double* x, const double* y, size_t n) {
+  std::array<double, 4> lanes{};
+  size_t r{};
+  for (; r + 4 <= n; r += 4) {
+    lanes[0] += x[r] * y[r];
+    lanes[1] += x[r + 1] * y[r + 1];
+    lanes[2] += x[r + 2] * y[r + 2];
+    lanes[3] += x[r + 3] * y[r + 3];
+  }
+  for (; r < n; ++r) {
+    lanes[0] += x[r] * y[r];
+  }
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/*
+gram product out = a^T b over column major a (rows x ka) and b (rows x kb),
+out is row major ka x kb. each 4x4 output tile is accumulated over 1024 row
+blocks so the eight input columns stay in l1, the inner loop runs down
+contiguous columns. tiles are independent and spread across threads, each
+output element is summed in the same order either way
+*/
+inline std::vector<double> gram(const std::vector<double>& a, size_t ka,
+                                const std::vector<double>& b, size_t kb,
+                                size_t rows) {
+  std::vector<double> out(ka * kb, 0.0);
+  const size_t tiles_a{(ka + tile - 1) / tile};
+
+  parallel::for_chunks(tiles_a, 1, [&](size_t, size_t begin, size_t end) {
+    for (size_t ti{begin}; ti < end; ++ti) {
+      const size_t i0{ti * tile};
+      const size_t ni{std::min(tile, ka - i0)};
+
+      for (size_t j0{}; j0 < kb; j0 += tile) {
+        const size_t nj{std::min(tile, kb - j0)};
+        std::array<std::array<double, tile>, tile> acc{};
+
+        for (size_t r0{}; r0 < rows; r0 += row_block) {
+          const size_t r1{std::min(rows, r0 + row_block)};
+          for (size_t i{}; i < ni; ++i) {
+            const double* col_a{a.data() + (i0 + i) * rows};
+            for (size_t j{}; j < nj; ++j) {
+              const double* col_b{b.data() + (j0 + j) * rows};
+              acc[i][j] += dot(col_a + r0, col_b + r0, r1 - r0);
+            }
+          }
+        }
+
+        for (size_t i{}; i < ni; ++i) {
+          for (size_t j{}; j < nj; ++j) {
+            out[(i0 + i) * kb + (j0 + j)] = acc[i][j];
+          }
+        }
+      }
+    }
+  });
+
+  return out;
+}
+}  // namespace linalg
+}  // namespace df
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace df {
+namespace merge {
+/*
+tournament tree of losers over k sorted runs. every internal node keeps the
+run that lost the match played there, so replacing the winner replays a
+single leaf to root path, log2 k comparisons per output row. equal keys are
+won by the lower run index, which keeps the merge stable across runs
+*/
+template <typename T>
+class LoserTree {
+ private:
+  std::vector<std::span<const T>> runs;
+  std::vector<size_t> positions;
+  std::vector<size_t> ends;
+  std::vector<size_t> losers;
+  size_t leaves{1};
+  size_t winner{};
+
+  bool exhausted(size_t run) const {
+    return run >= runs.size() || positions[run] == ends[run];
+  }
+
+  bool beats(size_t a, size_t b) const {
+    if (exhausted(a)) {
+      return false;
+    }
+    if (exhausted(b)) {
+      return true;
+    }
+
+    const T& key_a{runs[a][positions[a]]};
+    const T& key_b{runs[b][positions[b]]};
+    return key_a < key_b || (!(key_b < key_a) && a < b);
+  }
+
+ public:
+  LoserTree(std::vector<std::span<const T>> r, std::vector<size_t> begins,
+            std::vector<size_t> e)
+      : runs(std::move(r)), positions(std::move(begins)), ends(std::move(e)) {
+    while (leaves < runs.size()) {
+      leaves *= 2;
+    }
+    losers.assign(leaves, 0);
+
+    std::vector<size_t> winners(2 * leaves);
+    for (size_t i{}; i < leaves; ++i) {
+      winners[leaves + i] = i;
+    }
+    for (size_t node{leaves - 1}; node >= 1; --node) {
+      size_t a{winners[2 * node]};
+      size_t b{winners[2 * node + 1]};
+      winners[node] = beats(a, b) ? a : b;
+      losers[node] = beats(a, b) ? b : a;
+    }
+    winner = leaves > 1 ? winners[1] : 0;
+  }
+
+  bool empty() const { return exhausted(winner); }
+
+  // run and row of the smallest remaining key, then advances past it
+  std::pair<size_t, size_t> pop() {
+    std::pair<size_t, size_t> top{winner, positions[winner]++};
+
+    size_t current{winner};
+    for (size_t node{(winner + leaves) / 2}; node >= 1; node /= 2) {
+      if (beats(losers[node], current)) {
+        std::swap(losers[node], current);
+      }
+    }
+    winner = current;
+
+    return top;
+  }
+};
+
+/*
+merges rows [begins[i], ends[i]) of every run, writing the run index and row
+of each output position to sources and rows
+*/
+template <typename T>
+inline void kway(const std::vector<std::span<const T>>& runs,
+                 const std::vector<size_t>& begins,
+                 const std::vector<size_t>& ends, uint32_t* sources,
+                 size_t* rows) {
+  LoserTree<T> tree{runs, begins, ends};
+  for (size_t out{}; !tree.empty(); ++out) {
+    auto [run, row]{tree.pop()};
+    sources[out] = static_cast<uint32_t>(run);
+    rows[out] = row;
+  }
+}
+
+/*
+per run split positions for output rank, the k-way form of a merge path
+split. the splitter is the run key whose count of smaller keys across all
+runs lands closest to rank, found by binary search inside each run, and
+every run is cut at its lower bound. equal keys therefore never straddle a
+split, so merging the pieces independently stays stable
+*/
+template <typename T>
+inline std::vector<size_t> split_at_rank(
+    const std::vector<std::span<const T>>& runs, size_t rank) {
+  auto count_less = [&](const T& key) {
+    size_t count{};
+    for (const auto& run : runs) {
+      count += std::ranges::lower_bound(run, key) - run.begin();
+    }
+    return count;
+  };
+
+  const T* splitter{nullptr};
+  size_t best{};
+  auto consider = [&](const T& key) {
+    size_t count{count_less(key)};
+    size_t distance{count > rank ? count - rank : rank - count};
+    if (splitter == nullptr || distance < best) {
+      splitter = &key;
+      best = distance;
+    }
+  };
+
+  for (const auto& run : runs) {
+    size_t low{};
+    size_t high{run.size()};
+    while (low < high) {
+      size_t mid{low + (high - low) / 2};
+      if (count_less(run[mid]) < rank) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    if (low < run.size()) {
+      consider(run[low]);
+    }
+    if (low > 0) {
+      consider(run[low - 1]);
+    }
+  }
+
+  std::vector<size_t> split(runs.size(), 0);
+  for (size_t i{}; i < runs.size(); ++i) {
+    split[i] = splitter == nullptr
+                   ? 0
+                   : std::ranges::lower_bound(runs[i], *splitter) -
+                         runs[i].begin();
+  }
+  return split;
+}
+}  // namespace merge
+}  // namespace df
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace df {
+namespace parallel {
+inline size_t thread_count() {
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+// contiguous chunks of at least min_chunk items, at most one per thread
+inline size_t chunk_count(size_t n, size_t min_chunk) {
+  size_t by_size{std::max<size_t>(1, n / std::max<size_t>(1, min_chunk))};
+  return std::min(by_size, thread_count());
+}
+
+/*
+runs func(chunk, begin, end) over [0, n) split into chunk_count(n, min_chunk)
+contiguous chunks, the calling thread takes the first chunk.
+the first exception thrown by any chunk is rethrown after all have joined
+*/
+template <typename Func>
+inline void for_chunks(size_t n, size_t min_chunk, Func func) {
+  const size_t chunks{chunk_count(n, min_chunk)};
+  if (chunks <= 1) {
+    func(size_t{0}, size_t{0}, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(chunks);
+  auto run = [&](size_t chunk) {
+    size_t begin{n * chunk / chunks};
+    size_t end{n * (chunk + 1) / chunks};
+    try {
+      func(chunk, begin, end);
+    } catch (...) {
+      errors[chunk] = std::current_exception();
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers{};
+    workers.reserve(chunks - 1);
+    for (size_t chunk{1}; chunk < chunks; ++chunk) {
+      workers.emplace_back(run, chunk);
+    }
+    run(0);
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+}  // namespace parallel
+}  // namespace df
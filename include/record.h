@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+
+#include "column.h"
+
+namespace df {
+/*
+NOTE: compile time description of one struct member and the column it maps
+to, e.g. field<&Quote::bid>("bid"). the member pointer is a template
+argument, so reads and writes through it inline to plain loads and stores
+*/
+template <auto Member>
+struct Field;
+
+template <typename S, Storable T, T S::* Member>
+struct Field<Member> {
+  using record_type = S;
+  using value_type = T;
+
+  std::string name;
+
+  static const T& get(const S& record) { return record.*Member; }
+  static T& get(S& record) { return record.*Member; }
+};
+
+template <auto Member>
+Field<Member> field(std::string name) {
+  return Field<Member>{std::move(name)};
+}
+
+template <typename F, typename S>
+concept FieldOf = std::is_same_v<typename F::record_type, S>;
+}  // namespace df
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "parallel.h"
+#include "utils.h"
+
+namespace df {
+namespace reduce {
+/*
+NOTE: reductions are split into fixed size blocks whose boundaries depend
+only on the data length. every block is reduced on its own and the block
+results are combined by the same pairwise tree in block order, so the result
+is bit identical however the blocks are spread across threads
+*/
+inline constexpr size_t block_size{4096};
+inline constexpr size_t lanes{4};
+inline constexpr size_t blocks_per_chunk{16};
+
+// neumaier compensated accumulator
+struct Accumulator {
+  double sum{};
+  double compensation{};
+  size_t count{};
+
+  void add(double x) {
+    double t{sum + x};
+    compensation +=
+        std::abs(sum) >= std::abs(x) ? (sum - t) + x : (x - t) + sum;
+    sum = t;
+  }
+
+  void merge(const Accumulator& other) {
+    add(other.sum);
+    compensation += other.compensation;
+    count += other.count;
+  }
+
+  double result() const { return sum + compensation; }
+};
+
+/*
+one block, split across independent lanes so the loop carries no single
+dependency chain, nulls contribute zero
+*/
+template <typename T, typename Transform>
+inline Accumulator reduce_block(const T* values, size_t n,
+                                Transform transform) {
+  std::array<Accumulator, lanes> acc{};
+
+  size_t i{};
+  for (; i + lanes <= n; i += lanes) {
+    for (size_t lane{}; lane < lanes; ++lane) {
+      const T& value{values[i + lane]};
+      bool valid{!utils::is_null(value)};
+      acc[lane].add(valid ? transform(static_cast<double>(value)) : 0.0);
+      acc[lane].count += valid;
+    }
+  }
+  for (; i < n; ++i) {
+    bool valid{!utils::is_null(values[i])};
+    acc[0].add(valid ? transform(static_cast<double>(values[i])) : 0.0);
+    acc[0].count += valid;
+  }
+
+  acc[0].merge(acc[1]);
+  acc[2].merge(acc[3]);
+  acc[0].merge(acc[2]);
+  return acc[0];
+}
+
+inline Accumulator combine_pairwise(std::vector<Accumulator>& partials) {
+  if (partials.empty()) {
+    return Accumulator{};
+  }
+
+  for (size_t width{1}; width < partials.size(); width *= 2) {
+    for (size_t i{}; i + width < partials.size(); i += 2 * width) {
+      partials[i].merge(partials[i + width]);
+    }
+  }
+  return partials[0];
+}
+
+template <typename T, typename Transform>
+inline Accumulator transform_reduce(const T* values, size_t n,
+                                    Transform transform) {
+  const size_t blocks{(n + block_size - 1) / block_size};
+  std::vector<Accumulator> partials(blocks);
+
+  parallel::for_chunks(blocks, blocks_per_chunk,
+                       [&](size_t, size_t begin, size_t end) {
+                         for (size_t b{begin}; b < end; ++b) {
+                           size_t offset{b * block_size};
+                           size_t length{std::min(block_size, n - offset)};
+                           partials[b] =
+                               reduce_block(values + offset, length, transform);
+                         }
+                       });
+
+  return combine_pairwise(partials);
+}
+
+template <typename T>
+inline Accumulator sum(const T* values, size_t n) {
+  return transform_reduce(values, n, [](double x) { return x; });
+}
+
+// compensated sum of squared deviations from mean, the second variance pass
+template <typename T>
+inline Accumulator squared_deviations(const T* values, size_t n, double mean) {
+  return transform_reduce(values, n, [mean](double x) {
+    double d{x - mean};
+    return d * d;
+  });
+}
+}  // namespace reduce
+}  // namespace df
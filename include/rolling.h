@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "utils.h"
+
+namespace df {
+enum class RollingStat { Covariance, Correlation, Beta };
+
+namespace rolling {
+/*
+running co-moments with welford style add and remove, so a window moves in
+O(1) without the cancellation of the naive sum of products form
+*/
+struct CoMoments {
+  size_t n{};
+  double mean_x{};
+  double mean_y{};
+  double m2_x{};
+  double m2_y{};
+  double c_xy{};
+
+  void add(double x, double y) {
+    ++n;
+    double dx{x - mean_x};
+    mean_x += dx / n;
+    double dy{y - mean_y};
+    mean_y += dy / n;
+    m2_x += dx * (x - mean_x);
+    m2_y += dy * (y - mean_y);
+    c_xy += dx * (y - mean_y);
+  }
+
+  void remove(double x, double y) {
+    if (n <= 1) {
+      *this = CoMoments{};
+      return;
+    }
+
+    --n;
+    double dx{x - mean_x};
+    double dy{y - mean_y};
+    double next_mean_x{mean_x - dx / n};
+    double next_mean_y{mean_y - dy / n};
+    m2_x -= (x - next_mean_x) * dx;
+    m2_y -= (y - next_mean_y) * dy;
+    c_xy -= (x - next_mean_x) * dy;
+    mean_x = next_mean_x;
+    mean_y = next_mean_y;
+  }
+
+  // beta is the slope of y regressed on x
+  double value(RollingStat stat) const {
+    if (n < 2) {
+      return utils::get_null<double>();
+    }
+
+    switch (stat) {
+      case RollingStat::Covariance:
+        return c_xy / (n - 1);
+      case RollingStat::Correlation: {
+        double denominator{std::sqrt(m2_x * m2_y)};
+        return denominator > 0.0 ? c_xy / denominator
+                                 : utils::get_null<double>();
+      }
+      case RollingStat::Beta:
+        return m2_x > 0.0 ? c_xy / m2_x : utils::get_null<double>();
+    }
+    return utils::get_null<double>();
+  }
+};
+
+/*
+row windows over the rows listed in order, each output covers the last
+window listed rows ending at the current one. pairs with a null on either
+side are skipped, fewer than min_periods valid pairs gives null
+*/
+inline void by_rows(const std::vector<double>& x, const std::vector<double>& y,
+                    const std::vector<size_t>& order, size_t window,
+                    size_t min_periods, RollingStat stat,
+                    std::vector<double>& out) {
+  CoMoments moments{};
+  auto valid = [&](size_t row) {
+    return !utils::is_null(x[row]) && !utils::is_null(y[row]);
+  };
+
+  for (size_t k{}; k < order.size(); ++k) {
+    size_t row{order[k]};
+    if (valid(row)) {
+      moments.add(x[row], y[row]);
+    }
+
+    if (k >= window) {
+      size_t expired{order[k - window]};
+      if (valid(expired)) {
+        moments.remove(x[expired], y[expired]);
+      }
+    }
+
+    out[row] = moments.n >= min_periods ? moments.value(stat)
+                                        : utils::get_null<double>();
+  }
+}
+
+// time windows (t - duration, t] over rows listed in ascending time order
+inline void by_time(const std::vector<double>& x, const std::vector<double>& y,
+                    const std::vector<int64_t>& times,
+                    const std::vector<size_t>& order, int64_t duration,
+                    size_t min_periods, RollingStat stat,
+                    std::vector<double>& out) {
+  CoMoments moments{};
+  auto valid = [&](size_t row) {
+    return !utils::is_null(x[row]) && !utils::is_null(y[row]);
+  };
+
+  size_t tail{};
+  for (size_t k{}; k < order.size(); ++k) {
+    size_t row{order[k]};
+    if (utils::is_null(times[row])) {
+      throw std::invalid_argument("time column contains null values");
+    }
+    if (k > 0 && times[row] < times[order[k - 1]]) {
+      throw std::invalid_argument("time column must be sorted ascending");
+    }
+
+    if (valid(row)) {
+      moments.add(x[row], y[row]);
+    }
+
+    while (times[order[tail]] <= times[row] - duration) {
+      size_t expired{order[tail++]};
+      if (valid(expired)) {
+        moments.remove(x[expired], y[expired]);
+      }
+    }
+
+    out[row] = moments.n >= min_periods ? moments.value(stat)
+                                        : utils::get_null<double>();
+  }
+}
+}  // namespace rolling
+}  // namespace df
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hash.h"
+
+namespace df {
+namespace sketch {
+inline void write_file(const std::string& path,
+                       const std::vector<std::byte>& bytes) {
+  std::ofstream file{path, std::ios::binary};
+  if (!file.is_open()) {
+    throw std::runtime_error("failed to open sketch file: " + path);
+  }
+  file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+inline std::vector<std::byte> read_file(const std::string& path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file.is_open()) {
+    throw std::runtime_error("failed to open sketch file: " + path);
+  }
+
+  file.seekg(0, std::ios::end);
+  std::streamsize size{file.tellg()};
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> bytes(size);
+  file.read(reinterpret_cast<char*>(bytes.data()), size);
+  return bytes;
+}
+
+template <typename T>
+inline void append_bytes(std::vector<std::byte>& out, const T& value) {
+  const std::byte* value_bytes{reinterpret_cast<const std::byte*>(&value)};
+  out.insert(out.end(), value_bytes, value_bytes + sizeof(T));
+}
+
+template <typename T>
+inline T read_bytes(const std::vector<std::byte>& bytes, size_t& offset) {
+  if (offset + sizeof(T) > bytes.size()) {
+    throw std::runtime_error("truncated data, cannot read sketch");
+  }
+  T value{};
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+}  // namespace sketch
+
+/*
+hyperloglog distinct count, 2^precision one byte registers.
+standard error is about 1.04 / sqrt(2^precision), 0.8% at the default 14
+*/
+class HyperLogLog {
+ private:
+  uint8_t precision;
+  std::vector<uint8_t> registers;
+
+ public:
+  explicit HyperLogLog(uint8_t p = 14) : precision(p) {
+    if (p < 4 || p > 18) {
+      throw std::invalid_argument("hyperloglog precision must be in [4, 18]");
+    }
+    registers.assign(size_t{1} << p, 0);
+  }
+
+  uint8_t get_precision() const { return precision; }
+
+  void add_hash(uint64_t h) {
+    size_t index{static_cast<size_t>(h >> (64 - precision))};
+    // sentinel bit caps the rank when the remaining bits are all zero
+    uint64_t remaining{(h << precision) | (uint64_t{1} << (precision - 1))};
+    uint8_t rank{static_cast<uint8_t>(std::countl_zero(remaining) + 1)};
+    registers[index] = std::max(registers[index], rank);
+  }
+
+  template <typename T>
+  void add(const T& value) {
+    add_hash(hash::hash_value(value));
+  }
+
+  void merge(const HyperLogLog& other) {
+    if (other.precision != precision) {
+      throw std::invalid_argument(
+          "cannot merge sketches of different precision");
+    }
+    for (size_t i{}; i < registers.size(); ++i) {
+      registers[i] = std::max(registers[i], other.registers[i]);
+    }
+  }
+
+  double estimate() const {
+    const double m{static_cast<double>(registers.size())};
+
+    double harmonic{};
+    size_t zeros{};
+    for (const auto& r : registers) {
+      harmonic += std::ldexp(1.0, -static_cast<int>(r));
+      zeros += (r == 0);
+    }
+
+    double alpha{0.7213 / (1.0 + 1.079 / m)};
+    double raw{alpha * m * m / harmonic};
+
+    // linear counting is more accurate while many registers are empty
+    if (raw <= 2.5 * m && zeros > 0) {
+      return m * std::log(m / static_cast<double>(zeros));
+    }
+    return raw;
+  }
+
+  std::vector<std::byte> to_bytes() const {
+    std::vector<std::byte> bytes{};
+    bytes.reserve(1 + registers.size());
+    sketch::append_bytes(bytes, precision);
+    const std::byte* register_bytes{
+        reinterpret_cast<const std::byte*>(registers.data())};
+    bytes.insert(bytes.end(), register_bytes,
+                 register_bytes + registers.size());
+    return bytes;
+  }
+
+  static HyperLogLog from_bytes(const std::vector<std::byte>& bytes) {
+    size_t offset{};
+    HyperLogLog hll{sketch::read_bytes<uint8_t>(bytes, offset)};
+    if (bytes.size() - offset != hll.registers.size()) {
+      throw std::runtime_error("invalid byte vector size for hyperloglog");
+    }
+    std::memcpy(hll.registers.data(), bytes.data() + offset,
+                hll.registers.size());
+    return hll;
+  }
+
+  void to_binary(const std::string& path) const {
+    sketch::write_file(path, to_bytes());
+  }
+
+  static HyperLogLog from_binary(const std::string& path) {
+    return from_bytes(sketch::read_file(path));
+  }
+};
+
+/*
+merging t-digest with the k1 (arcsine) scale function, centroids are kept
+small near the tails so extreme percentiles stay accurate.
+values are buffered and folded in on compress. quantile and to_bytes are
+const, with values still buffered they work on a compressed copy, so call
+compress first before reading a digest many times
+*/
+class TDigest {
+ private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  double compression;
+  std::vector<Centroid> centroids;
+  std::vector<Centroid> buffer;
+  double total_weight{};
+  double min{std::numeric_limits<double>::infinity()};
+  double max{-std::numeric_limits<double>::infinity()};
+
+ public:
+  explicit TDigest(double c = 100.0) : compression(c) {
+    if (c < 10.0) {
+      throw std::invalid_argument("t-digest compression must be at least 10");
+    }
+  }
+
+  double get_compression() const { return compression; }
+
+  double count() const {
+    double buffered{};
+    for (const auto& c : buffer) {
+      buffered += c.weight;
+    }
+    return total_weight + buffered;
+  }
+
+  bool empty() const { return centroids.empty() && buffer.empty(); }
+
+  void add(double value, double weight = 1.0) {
+    buffer.push_back({value, weight});
+    min = std::min(min, value);
+    max = std::max(max, value);
+    if (buffer.size() >= buffer_limit()) {
+      compress();
+    }
+  }
+
+  void merge(const TDigest& other) {
+    for (const auto& c : other.centroids) {
+      buffer.push_back(c);
+    }
+    for (const auto& c : other.buffer) {
+      buffer.push_back(c);
+    }
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    compress();
+  }
+
+  double quantile(double q) const {
+    if (q < 0.0 || q > 1.0) {
+      throw std::invalid_argument("quantile must be between 0 and 1");
+    }
+
+    if (!buffer.empty()) {
+      return compressed().quantile(q);
+    }
+    if (centroids.empty()) {
+      throw std::invalid_argument("cannot get quantile of empty sketch");
+    }
+    if (centroids.size() == 1) {
+      return centroids.front().mean;
+    }
+
+    // centroid i covers the weight interval around its cumulative midpoint
+    double target{q * total_weight};
+    double cumulative{};
+    for (size_t i{}; i < centroids.size(); ++i) {
+      double half{centroids[i].weight / 2.0};
+      double mid{cumulative + half};
+
+      if (target < mid) {
+        if (i == 0) {
+          double fraction{half > 0.0 ? target / half : 0.0};
+          return min + (centroids[0].mean - min) * fraction;
+        }
+        double prev_mid{cumulative - centroids[i - 1].weight / 2.0};
+        double fraction{(target - prev_mid) / (mid - prev_mid)};
+        return centroids[i - 1].mean +
+               (centroids[i].mean - centroids[i - 1].mean) * fraction;
+      }
+      cumulative += centroids[i].weight;
+    }
+
+    const Centroid& last{centroids.back()};
+    double last_mid{total_weight - last.weight / 2.0};
+    double tail{total_weight - last_mid};
+    double fraction{tail > 0.0 ? (target - last_mid) / tail : 1.0};
+    return last.mean + (max - last.mean) * fraction;
+  }
+
+  void compress() {
+    if (buffer.empty()) {
+      return;
+    }
+
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::ranges::sort(buffer, [](const Centroid& a, const Centroid& b) {
+      return a.mean < b.mean;
+    });
+
+    double weight{};
+    for (const auto& c : buffer) {
+      weight += c.weight;
+    }
+
+    centroids.clear();
+    Centroid current{buffer.front()};
+    double cumulative{};
+    double limit{weight * k_inverse(k(0.0) + 1.0)};
+
+    for (size_t i{1}; i < buffer.size(); ++i) {
+      const Centroid& next{buffer[i]};
+      if (cumulative + current.weight + next.weight <= limit) {
+        double merged{current.weight + next.weight};
+        current.mean += (next.mean - current.mean) * next.weight / merged;
+        current.weight = merged;
+      } else {
+        cumulative += current.weight;
+        centroids.push_back(current);
+        limit = weight * k_inverse(k(cumulative / weight) + 1.0);
+        current = next;
+      }
+    }
+    centroids.push_back(current);
+
+    total_weight = weight;
+    buffer.clear();
+  }
+
+  std::vector<std::byte> to_bytes() const {
+    if (!buffer.empty()) {
+      return compressed().to_bytes();
+    }
+
+    std::vector<std::byte> bytes{};
+    bytes.reserve(sizeof(double) * 4 + sizeof(uint64_t) +
+                  centroids.size() * sizeof(Centroid));
+    sketch::append_bytes(bytes, compression);
+    sketch::append_bytes(bytes, total_weight);
+    sketch::append_bytes(bytes, min);
+    sketch::append_bytes(bytes, max);
+    sketch::append_bytes(bytes, static_cast<uint64_t>(centroids.size()));
+    for (const auto& c : centroids) {
+      sketch::append_bytes(bytes, c.mean);
+      sketch::append_bytes(bytes, c.weight);
+    }
+    return bytes;
+  }
+
+  static TDigest from_bytes(const std::vector<std::byte>& bytes) {
+    size_t offset{};
+    TDigest digest{sketch::read_bytes<double>(bytes, offset)};
+    digest.total_weight = sketch::read_bytes<double>(bytes, offset);
+    digest.min = sketch::read_bytes<double>(bytes, offset);
+    digest.max = sketch::read_bytes<double>(bytes, offset);
+
+    uint64_t n{sketch::read_bytes<uint64_t>(bytes, offset)};
+    digest.centroids.reserve(n);
+    for (uint64_t i{}; i < n; ++i) {
+      double mean{sketch::read_bytes<double>(bytes, offset)};
+      double weight{sketch::read_bytes<double>(bytes, offset)};
+      digest.centroids.push_back({mean, weight});
+    }
+
+    if (offset != bytes.size()) {
+      throw std::runtime_error("invalid byte vector size for t-digest");
+    }
+    return digest;
+  }
+
+  void to_binary(const std::string& path) const {
+    sketch::write_file(path, to_bytes());
+  }
+
+  static TDigest from_binary(const std::string& path) {
+    return from_bytes(sketch::read_file(path));
+  }
+
+ private:
+  // const readers fold pending values into a copy, the digest is untouched
+  TDigest compressed() const {
+    TDigest copy{*this};
+    copy.compress();
+    return copy;
+  }
+
+  size_t buffer_limit() const {
+    return static_cast<size_t>(compression) * 5;
+  }
+
+  double k(double q) const {
+    return compression / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+  }
+
+  double k_inverse(double value) const {
+    value = std::min(value, compression / 4.0);  // k(1.0)
+    double q{(std::sin(value * 2.0 * std::numbers::pi / compression) + 1.0) /
+             2.0};
+    return std::clamp(q, 0.0, 1.0);
+  }
+};
+}  // namespace df
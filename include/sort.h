@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace df {
+// auto uses the adaptive sort for numbers and the prefix radix sort for strings
+enum class SortMethod { Auto, Adaptive, Introsort };
+
+namespace sort {
+inline constexpr size_t min_run{32};
+inline constexpr size_t prefix_bytes{8};
+inline constexpr size_t radix_cutoff{64};
+
+template <typename T>
+inline bool is_sorted(const std::vector<T>& values, bool ascending) {
+  return ascending ? std::ranges::is_sorted(values)
+                   : std::ranges::is_sorted(values, std::ranges::greater{});
+}
+
+/*
+powersort node power of the boundary between adjacent runs [a, b) and
+[b, c) out of n, the first bit where the binary expansions of the two run
+midpoints over n differ
+*/
+inline size_t node_power(size_t a, size_t b, size_t c, size_t n) {
+  uint64_t left{a + b};
+  uint64_t right{b + c};
+  const uint64_t scale{2 * static_cast<uint64_t>(n)};
+
+  for (size_t power{1};; ++power) {
+    left *= 2;
+    right *= 2;
+    bool left_bit{left >= scale};
+    bool right_bit{right >= scale};
+    if (left_bit != right_bit) {
+      return power;
+    }
+    left -= left_bit ? scale : 0;
+    right -= right_bit ? scale : 0;
+  }
+}
+
+// stable, extends the sorted prefix [first, sorted) to [first, last)
+template <typename Less>
+inline void insertion_sort(size_t* first, size_t* sorted, size_t* last,
+                           Less less) {
+  for (size_t* it{sorted}; it < last; ++it) {
+    size_t* position{std::upper_bound(first, it, *it, less)};
+    std::rotate(position, it, it + 1);
+  }
+}
+
+// natural run at first, strictly descending runs are reversed in place
+template <typename Less>
+inline size_t* find_run(size_t* first, size_t* last, Less less) {
+  size_t* end{first + 1};
+  if (end == last) {
+    return end;
+  }
+
+  if (less(*end, *first)) {
+    while (end < last && less(*end, *(end - 1))) {
+      ++end;
+    }
+    std::reverse(first, end);
+  } else {
+    while (end < last && !less(*end, *(end - 1))) {
+      ++end;
+    }
+  }
+  return end;
+}
+
+// stable merge of [first, middle) and [middle, last) through buffer
+template <typename Less>
+inline void merge_runs(size_t* first, size_t* middle, size_t* last,
+                       std::vector<size_t>& buffer, Less less) {
+  if (!less(*middle, *(middle - 1))) {
+    return;  // already in order, the common case for nearly sorted input
+  }
+
+  // skip the prefix of the left run and the suffix of the right run that
+  // are already in place
+  first = std::upper_bound(first, middle, *middle, less);
+  last = std::lower_bound(middle, last, *(middle - 1), less);
+  buffer.assign(first, middle);
+
+  size_t* left{buffer.data()};
+  size_t* left_end{buffer.data() + buffer.size()};
+  size_t* right{middle};
+  size_t* out{first};
+  while (left < left_end && right < last) {
+    *out++ = less(*right, *left) ? *right++ : *left++;
+  }
+  std::copy(left, left_end, out);
+}
+
+/*
+NOTE: stable adaptive sort of row indices, powersort style. natural runs are
+found in one scan, short runs are padded to min_run by insertion sort and
+adjacent runs are merged in the order given by their node powers. sorted
+input is a single run and costs n - 1 comparisons, small out of order bursts
+only touch the runs around them
+*/
+template <typename Less>
+inline void adaptive_sort(std::span<size_t> indices, Less less) {
+  const size_t n{indices.size()};
+  if (n < 2) {
+    return;
+  }
+
+  struct Run {
+    size_t* begin;
+    size_t* end;
+  };
+
+  size_t* base{indices.data()};
+  size_t* last{base + n};
+  std::vector<Run> stack{};
+  std::vector<size_t> powers{};
+  std::vector<size_t> buffer{};
+
+  auto next_run = [&](size_t* first) {
+    size_t* end{find_run(first, last, less)};
+    if (static_cast<size_t>(end - first) < min_run) {
+      size_t* padded{std::min(last, first + min_run)};
+      insertion_sort(first, end, padded, less);
+      end = padded;
+    }
+    return Run{first, end};
+  };
+
+  auto merge_top = [&]() {
+    Run right{stack.back()};
+    stack.pop_back();
+    merge_runs(stack.back().begin, right.begin, right.end, buffer, less);
+    stack.back().end = right.end;
+  };
+
+  stack.push_back(next_run(base));
+  while (stack.back().end < last) {
+    Run run{next_run(stack.back().end)};
+    size_t power{node_power(stack.back().begin - base, run.begin - base,
+                            run.end - base, n)};
+
+    while (!powers.empty() && powers.back() > power) {
+      merge_top();
+      powers.pop_back();
+    }
+    powers.push_back(power);
+    stack.push_back(run);
+  }
+
+  while (stack.size() > 1) {
+    merge_top();
+  }
+}
+
+/*
+eight bytes of s from offset as a big endian integer, zero padded, so
+unsigned key order matches std::string order wherever the keys differ
+*/
+inline uint64_t prefix_key(std::string_view s, size_t offset) {
+  uint64_t key{};
+  for (size_t i{}; i < prefix_bytes; ++i) {
+    key <<= 8;
+    if (offset + i < s.size()) {
+      key |= static_cast<unsigned char>(s[offset + i]);
+    }
+  }
+  return key;
+}
+
+struct KeyedRow {
+  uint64_t key;
+  size_t row;
+};
+
+// stable lsd radix sort on the 64 bit keys, byte positions that are
+// constant across the range are skipped
+inline void radix_sort(std::span<KeyedRow> items,
+                       std::vector<KeyedRow>& scratch) {
+  std::array<std::array<size_t, 256>, prefix_bytes> counts{};
+  for (const auto& item : items) {
+    for (size_t d{}; d < prefix_bytes; ++d) {
+      ++counts[d][(item.key >> (8 * d)) & 0xff];
+    }
+  }
+
+  scratch.resize(items.size());
+  std::span<KeyedRow> from{items};
+  std::span<KeyedRow> to{scratch.data(), items.size()};
+
+  for (size_t d{}; d < prefix_bytes; ++d) {
+    auto& count{counts[d]};
+    if (std::ranges::find(count, items.size()) != count.end()) {
+      continue;
+    }
+
+    size_t total{};
+    for (auto& c : count) {
+      size_t next{total + c};
+      c = total;
+      total = next;
+    }
+    for (const auto& item : from) {
+      to[count[(item.key >> (8 * d)) & 0xff]++] = item;
+    }
+    std::swap(from, to);
+  }
+
+  if (from.data() != items.data()) {
+    std::ranges::copy(from, items.begin());
+  }
+}
+
+/*
+NOTE: msd sort by eight byte digits. each level radix sorts the cached
+prefixes, then recurses into runs of equal prefixes on the next eight bytes.
+runs that are small, or hold a string ending within the current digit, fall
+back to comparing the remaining suffixes. every step is stable
+*/
+inline void sort_strings(const std::vector<std::string>& values,
+                         std::span<KeyedRow> items, size_t offset,
+                         std::vector<KeyedRow>& scratch) {
+  radix_sort(items, scratch);
+
+  for (size_t begin{}; begin < items.size();) {
+    size_t end{begin + 1};
+    while (end < items.size() && items[end].key == items[begin].key) {
+      ++end;
+    }
+
+    std::span<KeyedRow> run{items.subspan(begin, end - begin)};
+    begin = end;
+    if (run.size() < 2) {
+      continue;
+    }
+
+    const size_t next{offset + prefix_bytes};
+    bool exhausted{std::ranges::any_of(run, [&](const KeyedRow& item) {
+      return values[item.row].size() <= next;
+    })};
+
+    if (exhausted || run.size() < radix_cutoff) {
+      std::ranges::stable_sort(run, [&](const KeyedRow& a, const KeyedRow& b) {
+        return std::string_view(values[a.row]).substr(offset) <
+               std::string_view(values[b.row]).substr(offset);
+      });
+      continue;
+    }
+
+    for (auto& item : run) {
+      item.key = prefix_key(values[item.row], next);
+    }
+    sort_strings(values, run, next, scratch);
+  }
+}
+
+/*
+stable string argsort, descending order reverses the ascending result and
+restores the original order within runs of equal strings
+*/
+inline std::vector<size_t> argsort_strings(
+    const std::vector<std::string>& values, bool ascending) {
+  std::vector<KeyedRow> items(values.size());
+  for (size_t i{}; i < values.size(); ++i) {
+    items[i] = {prefix_key(values[i], 0), i};
+  }
+
+  std::vector<KeyedRow> scratch{};
+  sort_strings(values, items, 0, scratch);
+
+  std::vector<size_t> indices(values.size());
+  for (size_t i{}; i < items.size(); ++i) {
+    indices[i] = items[i].row;
+  }
+
+  if (!ascending) {
+    std::ranges::reverse(indices);
+    for (size_t begin{}; begin < indices.size();) {
+      size_t end{begin + 1};
+      while (end < indices.size() &&
+             values[indices[end]] == values[indices[begin]]) {
+        ++end;
+      }
+      std::reverse(indices.begin() + begin, indices.begin() + end);
+      begin = end;
+    }
+  }
+  return indices;
+}
+
+template <typename T>
+inline std::vector<size_t> argsort(const std::vector<T>& values,
+                                   bool ascending,
+                                   SortMethod method = SortMethod::Auto) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    if (method == SortMethod::Auto) {
+      return argsort_strings(values, ascending);
+    }
+  }
+
+  std::vector<size_t> indices(values.size());
+  std::iota(indices.begin(), indices.end(), size_t{0});
+
+  auto sort_with = [&](auto less) {
+    if (method == SortMethod::Introsort) {
+      std::ranges::sort(indices, less);
+    } else {
+      adaptive_sort(std::span<size_t>(indices), less);
+    }
+  };
+
+  if (ascending) {
+    sort_with([&](size_t a, size_t b) { return values[a] < values[b]; });
+  } else {
+    sort_with([&](size_t a, size_t b) { return values[b] < values[a]; });
+  }
+  return indices;
+}
+}  // namespace sort
+}  // namespace df
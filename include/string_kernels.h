@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column.h"
+#include "compact_string.h"
+#include "parallel.h"
+#include "utils.h"
+
+namespace df {
+namespace strings {
+/*
+NOTE: whole column string kernels over Column<std::string> or
+CompactStringColumn. predicates return selection vectors of matching rows,
+transforms return new columns. nulls never match and map to null. rows are
+processed in parallel chunks, the byte loops are branch free so the
+compiler can vectorize them
+*/
+inline constexpr size_t chunk_rows{1 << 14};
+
+// unchecked row access as string views
+inline auto views(const Column<std::string>& column) {
+  auto data{column.begin()};
+  return [data](size_t i) { return std::string_view(data[i]); };
+}
+
+inline auto views(const CompactStringColumn& column) {
+  const std::vector<StringCell>& cells{column.get_cells()};
+  const std::vector<char>& buffer{column.get_buffer()};
+  return [&cells, &buffer](size_t i) { return cells[i].view(buffer); };
+}
+
+// rows where pred holds, per chunk selections are joined in row order
+template <typename Strings, typename Pred>
+inline std::vector<size_t> select(const Strings& column, Pred pred) {
+  auto at{views(column)};
+  const size_t n{column.nrows()};
+  const size_t chunks{parallel::chunk_count(n, chunk_rows)};
+  std::vector<std::vector<size_t>> parts(chunks);
+
+  parallel::for_chunks(n, chunk_rows,
+                       [&](size_t chunk, size_t begin, size_t end) {
+                         for (size_t i{begin}; i < end; ++i) {
+                           std::string_view value{at(i)};
+                           if (!value.empty() && pred(value)) {
+                             parts[chunk].push_back(i);
+                           }
+                         }
+                       });
+
+  std::vector<size_t> selection{};
+  for (const auto& part : parts) {
+    selection.insert(selection.end(), part.begin(), part.end());
+  }
+  return selection;
+}
+
+// column of func(value) for non null rows
+template <typename T, typename Strings, typename Func>
+inline Column<T> map(const Strings& column, Func func) {
+  auto at{views(column)};
+  std::vector<T> out(column.nrows(), utils::get_null<T>());
+
+  parallel::for_chunks(out.size(), chunk_rows,
+                       [&](size_t, size_t begin, size_t end) {
+                         for (size_t i{begin}; i < end; ++i) {
+                           std::string_view value{at(i)};
+                           if (!value.empty()) {
+                             out[i] = func(value);
+                           }
+                         }
+                       });
+  return Column<T>(std::move(out));
+}
+
+// =========================
+// predicates
+// =========================
+
+template <typename Strings>
+inline std::vector<size_t> equals(const Strings& column,
+                                  std::string_view value) {
+  return select(column, [value](std::string_view s) { return s == value; });
+}
+
+template <typename Strings>
+inline std::vector<size_t> starts_with(const Strings& column,
+                                       std::string_view prefix) {
+  return select(column,
+                [prefix](std::string_view s) { return s.starts_with(prefix); });
+}
+
+template <typename Strings>
+inline std::vector<size_t> ends_with(const Strings& column,
+                                     std::string_view suffix) {
+  return select(column,
+                [suffix](std::string_view s) { return s.ends_with(suffix); });
+}
+
+// longer needles share one boyer moore horspool table across all rows
+template <typename Strings>
+inline std::vector<size_t> contains(const Strings& column,
+                                    std::string_view needle) {
+  if (needle.size() < 4) {
+    return select(column, [needle](std::string_view s) {
+      return s.find(needle) != std::string_view::npos;
+    });
+  }
+
+  std::boyer_moore_horspool_searcher searcher{needle.begin(), needle.end()};
+  return select(column, [&searcher](std::string_view s) {
+    return std::search(s.begin(), s.end(), searcher) != s.end();
+  });
+}
+
+// =========================
+// transforms
+// =========================
+
+template <typename Strings>
+inline Column<int64_t> length(const Strings& column) {
+  return map<int64_t>(column, [](std::string_view s) {
+    return static_cast<int64_t>(s.size());
+  });
+}
+
+// ascii case mapping, other bytes pass through
+inline std::string map_case(std::string_view s, char first) {
+  std::string out(s);
+  for (auto& c : out) {
+    unsigned char byte{static_cast<unsigned char>(c)};
+    bool in_range{static_cast<unsigned char>(byte - first) < 26};
+    c = static_cast<char>(byte ^ (in_range << 5));
+  }
+  return out;
+}
+
+template <typename Strings>
+inline Column<std::string> upper(const Strings& column) {
+  return map<std::string>(column,
+                          [](std::string_view s) { return map_case(s, 'a'); });
+}
+
+template <typename Strings>
+inline Column<std::string> lower(const Strings& column) {
+  return map<std::string>(column,
+                          [](std::string_view s) { return map_case(s, 'A'); });
+}
+
+// bytes [start, start + count) clamped to each string
+template <typename Strings>
+inline Column<std::string> slice(const Strings& column, size_t start,
+                                 size_t count = std::string::npos) {
+  return map<std::string>(column, [start, count](std::string_view s) {
+    return std::string(start < s.size() ? s.substr(start, count) : "");
+  });
+}
+
+// zero based field index, missing fields are null
+template <typename Strings>
+inline Column<std::string> split_part(const Strings& column,
+                                      std::string_view delimiter,
+                                      size_t index) {
+  if (delimiter.empty()) {
+    throw std::invalid_argument("delimiter must not be empty");
+  }
+
+  return map<std::string>(column, [delimiter, index](std::string_view s) {
+    size_t begin{};
+    for (size_t field{}; field < index; ++field) {
+      size_t found{s.find(delimiter, begin)};
+      if (found == std::string_view::npos) {
+        return std::string{};
+      }
+      begin = found + delimiter.size();
+    }
+    return std::string(s.substr(begin, s.find(delimiter, begin) - begin));
+  });
+}
+}  // namespace strings
+}  // namespace df
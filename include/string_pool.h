@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "column.h"
+#include "hash.h"
+#include "hash_table.h"
+#include "parallel.h"
+#include "utils.h"
+
+namespace df {
+/*
+NOTE: append only string interning pool, opt in through intern(). strings
+are copied once into arena blocks that are never freed or moved, so views
+handed out stay valid for the life of the pool. the pool is split into
+shards by the high hash bits, each behind its own shared mutex, so lookups
+of known strings only take shared locks. an id packs the shard and the
+position within it, the empty string is null and maps to the null id
+*/
+class StringPool {
+ private:
+  static constexpr size_t shard_bits{6};
+  static constexpr size_t shard_count{size_t{1} << shard_bits};
+  static constexpr size_t block_size{size_t{1} << 16};
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    FlatHashMap<std::string_view, int64_t> ids;
+    std::vector<std::string_view> strings;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<std::unique_ptr<char[]>> large;
+    size_t used{block_size};
+
+    // large strings get their own allocation so blocks stay densely filled
+    std::string_view store(std::string_view s) {
+      char* target{nullptr};
+      if (s.size() > block_size / 4) {
+        large.push_back(std::make_unique<char[]>(s.size()));
+        target = large.back().get();
+      } else {
+        if (used + s.size() > block_size) {
+          blocks.push_back(std::make_unique<char[]>(block_size));
+          used = 0;
+        }
+        target = blocks.back().get() + used;
+        used += s.size();
+      }
+      std::memcpy(target, s.data(), s.size());
+      return {target, s.size()};
+    }
+  };
+
+  std::array<Shard, shard_count> shards{};
+
+ public:
+  StringPool() = default;
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  // process wide pool shared by every frame
+  static StringPool& global() {
+    static StringPool pool{};
+    return pool;
+  }
+
+  int64_t intern(std::string_view s) {
+    if (s.empty()) {
+      return utils::get_null<int64_t>();
+    }
+
+    size_t index{hash::hash_bytes(s.data(), s.size()) >> (64 - shard_bits)};
+    Shard& shard{shards[index]};
+
+    {
+      std::shared_lock lock{shard.mutex};
+      if (const int64_t* id{shard.ids.find(s)}) {
+        return *id;
+      }
+    }
+
+    std::unique_lock lock{shard.mutex};
+    if (const int64_t* id{shard.ids.find(s)}) {
+      return *id;  // interned by another thread in between
+    }
+
+    std::string_view stored{shard.store(s)};
+    int64_t id{static_cast<int64_t>((shard.strings.size() << shard_bits) |
+                                    index)};
+    shard.strings.push_back(stored);
+    shard.ids[stored] = id;
+    return id;
+  }
+
+  std::string_view view(int64_t id) const {
+    if (utils::is_null(id)) {
+      return {};
+    }
+
+    const Shard& shard{shards[static_cast<size_t>(id) & (shard_count - 1)]};
+    size_t position{static_cast<size_t>(id) >> shard_bits};
+
+    std::shared_lock lock{shard.mutex};
+    if (id < 0 || position >= shard.strings.size()) {
+      throw std::out_of_range("unknown interned string id");
+    }
+    return shard.strings[position];
+  }
+
+  size_t size() const {
+    size_t total{};
+    for (const auto& shard : shards) {
+      std::shared_lock lock{shard.mutex};
+      total += shard.strings.size();
+    }
+    return total;
+  }
+
+  // =========================
+  // column methods
+  // =========================
+
+  Column<int64_t> intern(const Column<std::string>& column) {
+    std::vector<int64_t> ids(column.nrows());
+    auto data{column.begin()};
+    parallel::for_chunks(ids.size(), 1 << 14,
+                         [&](size_t, size_t begin, size_t end) {
+                           for (size_t i{begin}; i < end; ++i) {
+                             ids[i] = intern(data[i]);
+                           }
+                         });
+    return Column<int64_t>(std::move(ids));
+  }
+
+  Column<std::string> resolve(const Column<int64_t>& ids) const {
+    std::vector<std::string> values(ids.nrows());
+    auto data{ids.begin()};
+    parallel::for_chunks(values.size(), 1 << 14,
+                         [&](size_t, size_t begin, size_t end) {
+                           for (size_t i{begin}; i < end; ++i) {
+                             values[i] = std::string(view(data[i]));
+                           }
+                         });
+    return Column<std::string>(std::move(values));
+  }
+};
+}  // namespace df
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace df {
+namespace sweep {
+/*
+for every probe row, listed by ascending lo, the range of positions in build,
+listed by ascending point, whose points fall in [lo, hi]. the window start
+only moves forward and the scan past it stops at the first point above hi,
+so a pass costs O(n + m + matches). ranges are offset into a shared buffer
+*/
+template <typename T>
+inline void match_ranges(const std::vector<T>& points,
+                         std::span<const size_t> build,
+                         const std::vector<T>& lo, const std::vector<T>& hi,
+                         std::span<const size_t> probe, size_t offset,
+                         std::vector<std::pair<size_t, size_t>>& ranges) {
+  size_t start{};
+  for (const size_t row : probe) {
+    while (start < build.size() && points[build[start]] < lo[row]) {
+      ++start;
+    }
+
+    size_t stop{start};
+    while (stop < build.size() && points[build[stop]] <= hi[row]) {
+      ++stop;
+    }
+    ranges[row] = {offset + start, offset + stop};
+  }
+}
+}  // namespace sweep
+}  // namespace df
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csv.h"
+#include "dataframe.h"
+
+namespace df {
+// string literal usable as a template argument, e.g. Col<"px", double>
+template <size_t N>
+struct FixedString {
+  char chars[N]{};
+
+  constexpr FixedString(const char (&s)[N]) { std::copy_n(s, N, chars); }
+
+  constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+template <FixedString Name, Storable T>
+struct Col {
+  static constexpr std::string_view name{Name.view()};
+  using value_type = T;
+};
+
+/*
+NOTE: frame with its schema fixed at compile time. columns live in a tuple
+and are found by name during compilation, so access, sorting, filters and
+aggregations are typed calls with no variant visit or map lookup. the
+columns are the same Column<T> a DataFrame holds, conversion either way is
+a copy per column, or a move out of an rvalue frame
+*/
+template <typename... Cols>
+class TypedFrame {
+  static_assert(sizeof...(Cols) > 0, "typed frame needs at least one column");
+
+ private:
+  using Columns = std::tuple<Column<typename Cols::value_type>...>;
+  using Sequence = std::index_sequence_for<Cols...>;
+
+  static constexpr std::array<std::string_view, sizeof...(Cols)> names{
+      Cols::name...};
+
+  static consteval bool unique_names() {
+    for (size_t i{}; i < names.size(); ++i) {
+      for (size_t j{i + 1}; j < names.size(); ++j) {
+        if (names[i] == names[j]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  static_assert(unique_names(), "duplicate column names");
+
+  template <FixedString Name>
+  static consteval size_t index_of() {
+    for (size_t i{}; i < names.size(); ++i) {
+      if (names[i] == Name.view()) {
+        return i;
+      }
+    }
+    return names.size();
+  }
+
+  Columns columns;
+
+ public:
+  template <FixedString Name>
+  static constexpr bool has = index_of<Name>() < sizeof...(Cols);
+
+  template <FixedString Name>
+    requires has<Name>
+  using value_type_of = std::tuple_element_t<
+      index_of<Name>(), std::tuple<typename Cols::value_type...>>;
+
+  // =====================================
+  // constructors and conversion
+  // =====================================
+
+  TypedFrame() = default;
+
+  static TypedFrame from_dataframe(const DataFrame& frame) {
+    TypedFrame typed{};
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((std::get<I>(typed.columns) = *source<I>(frame)), ...);
+    }(Sequence{});
+    return typed;
+  }
+
+  static TypedFrame from_dataframe(DataFrame&& frame) {
+    TypedFrame typed{};
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((std::get<I>(typed.columns) = std::move(*source<I>(frame))), ...);
+    }(Sequence{});
+    return typed;
+  }
+
+  /*
+  NOTE: parser specialized to the schema, the header must list the schema
+  columns in order. each line is split and parsed field by field in an
+  unrolled sequence writing straight into the column buffers, with no
+  token vector or variant visit. large inputs are cut at line boundaries
+  and parsed in parallel chunks that are concatenated in order
+  */
+  static TypedFrame read_csv(const std::string& path, char delimiter = ',') {
+    std::string buffer{csv::read_file(path)};
+    if (buffer.find('\n') == std::string::npos) {
+      throw std::invalid_argument("missing header in file: " + path);
+    }
+    return parse_csv(buffer, delimiter,
+                     parallel::chunk_count(buffer.size(),
+                                           csv::min_chunk_bytes));
+  }
+
+  static TypedFrame parse_csv(std::string_view text, char delimiter = ',',
+                              size_t chunks = 1) {
+    size_t header_end{std::min(text.find('\n'), text.size())};
+    std::vector<std::string_view> headers{
+        utils::to_tokens(text.substr(0, header_end), delimiter)};
+    if (!std::ranges::equal(headers, names)) {
+      throw std::invalid_argument("csv header does not match schema");
+    }
+
+    std::string_view body{text.substr(std::min(header_end + 1, text.size()))};
+    std::vector<size_t> bounds{
+        csv::line_bounds(body, std::max<size_t>(1, chunks))};
+    const size_t parts_count{bounds.size() - 1};
+
+    // line numbers for error messages, the header is line 1
+    std::vector<size_t> first_lines(parts_count, 2);
+    for (size_t c{1}; c < parts_count; ++c) {
+      first_lines[c] =
+          first_lines[c - 1] + std::count(body.begin() + bounds[c - 1],
+                                           body.begin() + bounds[c], '\n');
+    }
+
+    std::vector<TypedFrame> parts(parts_count);
+    parallel::for_chunks(parts_count, 1, [&](size_t, size_t begin, size_t end) {
+      for (size_t c{begin}; c < end; ++c) {
+        parts[c].parse_lines(body.substr(bounds[c], bounds[c + 1] - bounds[c]),
+                             delimiter, first_lines[c]);
+      }
+    });
+
+    size_t total{};
+    for (const auto& part : parts) {
+      total += part.nrows();
+    }
+
+    TypedFrame result{std::move(parts[0])};
+    result.reserve(total);
+    for (size_t c{1}; c < parts_count; ++c) {
+      result.concat(std::move(parts[c]));
+    }
+    return result;
+  }
+
+  DataFrame to_dataframe() const& {
+    std::unordered_map<std::string, ColumnVariant> output{};
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (output.emplace(std::string{names[I]}, std::get<I>(columns)), ...);
+    }(Sequence{});
+    return DataFrame(nrows(), ncols(), {names.begin(), names.end()},
+                     std::move(output));
+  }
+
+  DataFrame to_dataframe() && {
+    const size_t n{nrows()};
+    std::unordered_map<std::string, ColumnVariant> output{};
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (output.emplace(std::string{names[I]}, std::move(std::get<I>(columns))),
+       ...);
+    }(Sequence{});
+    return DataFrame(n, ncols(), {names.begin(), names.end()},
+                     std::move(output));
+  }
+
+  // =====================================
+  // size and column methods
+  // =====================================
+
+  size_t nrows() const { return std::get<0>(columns).nrows(); }
+  static constexpr size_t ncols() { return sizeof...(Cols); }
+  bool empty() const { return nrows() == 0; }
+
+  static constexpr const auto& column_names() { return names; }
+
+  template <FixedString Name>
+    requires has<Name>
+  const Column<value_type_of<Name>>& column() const {
+    return std::get<index_of<Name>()>(columns);
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  Column<value_type_of<Name>>& column() {
+    return std::get<index_of<Name>()>(columns);
+  }
+
+  // unchecked contiguous view for hot loops
+  template <FixedString Name>
+    requires has<Name>
+  std::span<const value_type_of<Name>> values() const {
+    const auto& data{column<Name>().data};
+    return {data.data(), data.size()};
+  }
+
+  // =====================================
+  // row methods
+  // =====================================
+
+  void reserve(size_t capacity) {
+    std::apply([&](auto&... column) { (column.reserve(capacity), ...); },
+               columns);
+  }
+
+  void append(typename Cols::value_type... values) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (std::get<I>(columns).append(std::move(values)), ...);
+    }(Sequence{});
+  }
+
+  // =====================================
+  // selection and sorting methods
+  // =====================================
+
+  TypedFrame take(const std::vector<size_t>& indices) const {
+    for (const auto& index : indices) {
+      if (index >= nrows()) {
+        throw std::out_of_range("index out of range");
+      }
+    }
+
+    TypedFrame result{};
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (gather(std::get<I>(columns), indices, std::get<I>(result.columns)),
+       ...);
+    }(Sequence{});
+    return result;
+  }
+
+  // rows whose value satisfies pred, nulls never match
+  template <FixedString Name, typename Pred>
+    requires has<Name>
+  TypedFrame filter(Pred pred) const {
+    const auto& data{column<Name>().data};
+    std::vector<size_t> selection{};
+    for (size_t i{}; i < data.size(); ++i) {
+      if (!utils::is_null(data[i]) && pred(data[i])) {
+        selection.push_back(i);
+      }
+    }
+    return take(selection);
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  TypedFrame between(const value_type_of<Name>& lo,
+                     const value_type_of<Name>& hi) const {
+    return take(column<Name>().between(lo, hi));
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  TypedFrame isin(const std::vector<value_type_of<Name>>& values) const {
+    return take(column<Name>().isin(values));
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  TypedFrame& sort_by(bool ascending = true,
+                      SortMethod method = SortMethod::Auto) {
+    const auto& data{column<Name>().data};
+    if (!sort::is_sorted(data, ascending)) {
+      *this = take(sort::argsort(data, ascending, method));
+    }
+    return *this;
+  }
+
+  // =====================================
+  // statistical methods
+  // =====================================
+
+  template <FixedString Name>
+    requires has<Name>
+  size_t count() const {
+    return nrows() - column<Name>().get_null_count();
+  }
+
+  template <FixedString Name>
+    requires has<Name> && std::is_arithmetic_v<value_type_of<Name>>
+  double sum() const {
+    return column<Name>().sum();
+  }
+
+  template <FixedString Name>
+    requires has<Name> && std::is_arithmetic_v<value_type_of<Name>>
+  double mean() const {
+    return column<Name>().mean();
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  value_type_of<Name> minimum() const {
+    return column<Name>().minimum();
+  }
+
+  template <FixedString Name>
+    requires has<Name>
+  value_type_of<Name> maximum() const {
+    return column<Name>().maximum();
+  }
+
+ private:
+  void parse_lines(std::string_view text, char delimiter, size_t line_number) {
+    reserve(std::count(text.begin(), text.end(), '\n') + 1);
+
+    size_t line_start{};
+    while (line_start < text.size()) {
+      size_t line_end{std::min(text.find('\n', line_start), text.size())};
+      std::string_view line{text.substr(line_start, line_end - line_start)};
+      if (!utils::trim(line).empty()) {
+        parse_line(line, delimiter, line_number);
+      }
+      line_start = line_end + 1;
+      ++line_number;
+    }
+  }
+
+  void parse_line(std::string_view line, char delimiter, size_t line_number) {
+    size_t pos{};
+    std::string_view field{};
+    bool complete{[&]<size_t... I>(std::index_sequence<I...>) {
+      return ((csv::next_field(line, pos, delimiter, field) &&
+               (append_field(std::get<I>(columns), field), true)) &&
+              ...);
+    }(Sequence{})};
+
+    if (!complete || pos <= line.size()) {
+      throw std::runtime_error(
+          "malformed line " + std::to_string(line_number) + ": expected " +
+          std::to_string(ncols()) + " columns, got " +
+          std::to_string(utils::to_tokens(line, delimiter).size()));
+    }
+  }
+
+  template <typename T>
+  static void append_field(Column<T>& column, std::string_view field) {
+    column.append(csv::parse_field<T>(field));
+  }
+
+  void concat(TypedFrame&& other) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (std::get<I>(columns).extend(std::move(std::get<I>(other.columns))),
+       ...);
+    }(Sequence{});
+  }
+
+  template <size_t I, typename Frame>
+  static auto* source(Frame& frame) {
+    using T = std::tuple_element_t<I, std::tuple<typename Cols::value_type...>>;
+    auto* column{frame.template get_column<T>(std::string{names[I]})};
+    if (column == nullptr) {
+      throw std::invalid_argument("no column '" + std::string{names[I]} +
+                                  "' of the declared type");
+    }
+    if (column->nrows() != frame.nrows()) {
+      throw std::invalid_argument("column length does not match frame");
+    }
+    return column;
+  }
+
+  template <typename T>
+  static void gather(const Column<T>& from, const std::vector<size_t>& indices,
+                     Column<T>& to) {
+    std::vector<T> values(indices.size());
+    size_t nulls{};
+    for (size_t i{}; i < indices.size(); ++i) {
+      values[i] = from.data[indices[i]];
+      nulls += utils::is_null(values[i]);
+    }
+    to = Column<T>{std::move(values), nulls};
+    to.inherit(from);
+  }
+};
+
+template <typename Schema>
+Schema read_csv(const std::string& path, char delimiter = ',') {
+  return Schema::read_csv(path, delimiter);
+}
+}  // namespace df
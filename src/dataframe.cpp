@@ -2,12 +2,26 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <ranges>
-
+#include <sstream>
+
+#include "bloom.h"
+#include "dispatch.h"
+#include "hash.h"
+#include "hash_table.h"
+#include "linalg.h"
+#include "merge.h"
+#include "parallel.h"
+#include "reduce.h"
+#include "string_pool.h"
+#include "sweep.h"
 #include "utils.h"
 
 namespace df {
@@ -152,8 +166,6 @@ void DataFrame::to_csv(const std::string& csv, char delimiter) const {
     throw std::runtime_error("failed to open csv file: " + csv);
   }
 
-  file << std::setprecision(17);
-
   for (size_t i{}; i < column_info.size(); ++i) {
     file << column_info[i];
     if (i < column_info.size() - 1) {
@@ -162,25 +174,33 @@ void DataFrame::to_csv(const std::string& csv, char delimiter) const {
   }
   file << '\n';
 
-  for (size_t i{}; i < rows; ++i) {
+  // each column formats a block of cells at a time, then rows are stitched
+  constexpr size_t block{4096};
+  const dispatch::CellFormat format{};
+  std::vector<dispatch::Cells> cells(column_info.size());
+  std::string text{};
+
+  for (size_t begin{}; begin < rows; begin += block) {
+    const size_t end{std::min(rows, begin + block)};
     for (size_t j{}; j < column_info.size(); ++j) {
-      const auto& col{columns.at(column_info[j])};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            if (!utils::is_null<T>(column[i])) {
-              file << column[i];
-            }
-          },
-          col);
+      cells[j].clear();
+      dispatch::run<dispatch::FormatCells>(columns.at(column_info[j]), begin,
+                                           end, format, cells[j]);
+    }
 
-      if (j < column_info.size() - 1) {
-        file << delimiter;
+    text.clear();
+    for (size_t i{begin}; i < end; ++i) {
+      for (size_t j{}; j < column_info.size(); ++j) {
+        text += cells[j][i - begin];
+        if (j < column_info.size() - 1) {
+          text += delimiter;
+        }
+      }
+      if (i < rows - 1) {
+        text += '\n';
       }
     }
-    if (i < rows - 1) {
-      file << '\n';
-    }
+    file.write(text.data(), text.size());
   }
 }
 
@@ -416,6 +436,62 @@ void DataFrame::drop_column(const std::string& column_name) {
   --cols;
 }
 
+/*
+NOTE: replaces a string column by its ids in the global string pool, so the
+column joins, groups and compares as integers and repeated strings are
+stored once per process. resolve turns the ids back into strings, and only
+accepts columns intern produced, or copies of their rows through sorts,
+takes, slices, joins and reshapes
+*/
+DataFrame& DataFrame::intern(const std::string& column_name) {
+  Column<std::string>* col{get_column<std::string>(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column must be an existing string column: " +
+                                column_name);
+  }
+
+  Column<int64_t> ids{StringPool::global().intern(*col)};
+  ids.interned = true;
+  columns[column_name] = std::move(ids);
+  return *this;
+}
+
+DataFrame& DataFrame::resolve(const std::string& column_name) {
+  Column<int64_t>* col{get_column<int64_t>(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column must be an existing int column: " +
+                                column_name);
+  }
+  if (!col->interned) {
+    throw std::invalid_argument("column was not produced by intern: " +
+                                column_name);
+  }
+
+  columns[column_name] = StringPool::global().resolve(*col);
+  return *this;
+}
+
+// indexes follow appends and row copies (see Column::inherit)
+DataFrame& DataFrame::build_index(const std::string& column_name) {
+  ColumnVariant* col{get_column(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  std::visit([](auto& column) { column.build_index(); }, *col);
+  return *this;
+}
+
+DataFrame& DataFrame::drop_index(const std::string& column_name) {
+  ColumnVariant* col{get_column(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  std::visit([](auto& column) { column.drop_index(); }, *col);
+  return *this;
+}
+
 // =====================================
 // row methods
 // =====================================
@@ -569,29 +645,14 @@ DataFrame& DataFrame::dropna(const std::vector<std::string>& subset,
     target_columns = &subset;
   }
 
-  std::vector<size_t> removal_indices{};
+  std::vector<size_t> counts(rows, 0);
+  for (const auto& column_name : *target_columns) {
+    dispatch::run<dispatch::CountNulls>(columns.at(column_name), counts);
+  }
 
+  std::vector<size_t> removal_indices{};
   for (size_t i{0}; i < rows; ++i) {
-    bool remove{false};
-    size_t count{};
-
-    for (const auto& column_name : *target_columns) {
-      const auto& col{columns.at(column_name)};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            if (utils::is_null<T>(column[i])) {
-              ++count;
-            }
-          },
-          col);
-
-      if (count > threshold) {
-        remove = true;
-      }
-    }
-
-    if (remove) {
+    if (counts[i] > threshold) {
       removal_indices.push_back(i);
     }
   }
@@ -610,15 +671,16 @@ DataFrame& DataFrame::drop_duplicates(const std::vector<std::string>& subset) {
     target_columns = &subset;
   }
 
-  std::unordered_set<size_t> seen{};
+  std::vector<uint64_t> row_hashes{
+      compute_row_hashes(*this, *target_columns)};
+
+  std::unordered_set<uint64_t> seen{};
+  seen.reserve(rows);
   std::vector<size_t> removal_indices{};
 
   for (size_t i{0}; i < rows; ++i) {
-    size_t row_hash{compute_row_hash(*this, i, *target_columns)};
-    if (seen.contains(row_hash)) {
+    if (!seen.insert(row_hashes[i]).second) {
       removal_indices.push_back(i);
-    } else {
-      seen.insert(row_hash);
     }
   }
 
@@ -693,48 +755,39 @@ DataFrame& DataFrame::bfill(const std::vector<std::string>& subset) {
 // selection and sorting methods
 // =====================================
 
-DataFrame& DataFrame::sort_by(const std::string& column_name, bool ascending) {
-  std::vector<size_t> indices{};
-  for (size_t i{0}; i < rows; ++i) {
-    indices.push_back(i);
-  }
-
+/*
+NOTE: a column already in the requested order returns immediately. the
+default picks the adaptive sort for numbers, linear on presorted runs, and
+the prefix radix sort for strings. both are stable, introsort keeps the
+unstable std::ranges::sort path
+*/
+DataFrame& DataFrame::sort_by(const std::string& column_name, bool ascending,
+                              SortMethod method) {
   auto it{columns.find(column_name)};
   if (it == columns.end()) {
     throw std::invalid_argument("column not found: " + column_name);
   }
-  auto& target{it->second};
-
-  std::ranges::sort(indices, [&target, ascending](size_t a, size_t b) {
-    return std::visit(
-        [&](const auto& column) {
-          const auto& val_a = column[a];
-          const auto& val_b = column[b];
-
-          if (ascending) {
-            return val_a < val_b;
-          } else {
-            return val_a > val_b;
-          }
-        },
-        target);
-  });
-
-  for (auto& [col, column] : columns) {
-    auto sorted_column{std::visit(
-        [&](const auto& old_column) {
-          using T = std::decay_t<decltype(old_column)>::value_type;
 
-          Column<T> new_column{Column<T>(indices.size())};
-          for (size_t i{0}; i < indices.size(); ++i) {
-            new_column.append(old_column[indices[i]]);
-          }
+  std::vector<size_t> indices{};
+  bool sorted{std::visit(
+      [&](const auto& column) {
+        if (sort::is_sorted(column.data, ascending)) {
+          return true;
+        }
+        indices = sort::argsort(column.data, ascending, method);
+        return false;
+      },
+      it->second)};
 
-          return ColumnVariant(std::in_place_type<Column<T>>, new_column);
-        },
-        column)};
+  if (sorted) {
+    return *this;
+  }
 
-    columns[col] = std::move(sorted_column);
+  for (auto& [_, column] : columns) {
+    ColumnVariant sorted_column{};
+    dispatch::run<dispatch::Gather>(std::as_const(column), indices,
+                                    sorted_column);
+    column = std::move(sorted_column);
   }
 
   return *this;
@@ -783,7 +836,9 @@ DataFrame DataFrame::slice(size_t start, size_t end) const {
         [&](const auto& column) {
           using T = std::decay_t<decltype(column)>::value_type;
           std::vector<T> copy{column.begin() + start, column.begin() + end};
-          df.columns[column_name] = Column<T>(std::move(copy));
+          Column<T> sliced(std::move(copy));
+          sliced.inherit(column);
+          df.columns[column_name] = std::move(sliced);
         },
         col);
   }
@@ -794,6 +849,131 @@ DataFrame DataFrame::slice(size_t start, size_t end) const {
   return df;
 }
 
+DataFrame DataFrame::take(const std::vector<size_t>& indices) const {
+  for (const auto& index : indices) {
+    if (index >= rows) {
+      throw std::out_of_range("index out of range");
+    }
+  }
+
+  DataFrame df{};
+  df.column_info = column_info;
+
+  for (const auto& column_name : column_info) {
+    dispatch::run<dispatch::Gather>(columns.at(column_name), indices,
+                                    df.columns[column_name]);
+  }
+
+  df.rows = indices.size();
+  df.cols = column_info.size();
+
+  return df;
+}
+
+/*
+NOTE: frames must share a schema and each be sorted ascending on key. a
+loser tree merge yields the output permutation as (frame, row) pairs, then
+every column is gathered once. with enough rows the output is cut into
+ranges by k-way splits and each range is merged on its own thread. equal
+keys keep frame order
+*/
+DataFrame DataFrame::merge_sorted(const std::vector<DataFrame>& frames,
+                                  const std::string& key) {
+  if (frames.empty()) {
+    throw std::invalid_argument("no frames indicated for merging");
+  }
+
+  const DataFrame& first{frames.front()};
+  first.validate_subset({key});
+
+  size_t total{};
+  for (const auto& frame : frames) {
+    if (frame.column_info != first.column_info) {
+      throw std::invalid_argument("frames must share the same columns");
+    }
+    for (const auto& column_name : first.column_info) {
+      if (frame.columns.at(column_name).index() !=
+          first.columns.at(column_name).index()) {
+        throw std::invalid_argument("column types differ between frames: " +
+                                    column_name);
+      }
+    }
+    total += frame.rows;
+  }
+
+  std::vector<uint32_t> sources(total);
+  std::vector<size_t> positions(total);
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+
+        std::vector<std::span<const T>> runs{};
+        for (const auto& frame : frames) {
+          const std::vector<T>& keys{
+              std::get<Column<T>>(frame.columns.at(key)).data};
+          if (!std::ranges::is_sorted(keys)) {
+            throw std::invalid_argument("frames must be sorted by key: " +
+                                        key);
+          }
+          runs.emplace_back(keys);
+        }
+
+        const size_t pieces{parallel::chunk_count(total, 1 << 16)};
+        std::vector<std::vector<size_t>> splits(pieces + 1);
+        splits.front().assign(runs.size(), 0);
+        for (size_t i{}; i < runs.size(); ++i) {
+          splits.back().push_back(runs[i].size());
+        }
+        for (size_t p{1}; p < pieces; ++p) {
+          splits[p] = merge::split_at_rank(runs, total * p / pieces);
+        }
+
+        parallel::for_chunks(pieces, 1, [&](size_t, size_t begin,
+                                            size_t end) {
+          for (size_t p{begin}; p < end; ++p) {
+            size_t offset{std::accumulate(splits[p].begin(), splits[p].end(),
+                                          size_t{0})};
+            merge::kway(runs, splits[p], splits[p + 1],
+                        sources.data() + offset, positions.data() + offset);
+          }
+        });
+      },
+      first.columns.at(key));
+
+  DataFrame df{};
+  df.column_info = first.column_info;
+
+  for (const auto& column_name : first.column_info) {
+    std::visit(
+        [&](const auto& column) {
+          using T = std::decay_t<decltype(column)>::value_type;
+          std::vector<const std::vector<T>*> inputs{};
+          for (const auto& frame : frames) {
+            inputs.push_back(
+                &std::get<Column<T>>(frame.columns.at(column_name)).data);
+          }
+
+          std::vector<T> gathered(total);
+          parallel::for_chunks(
+              total, 1 << 16, [&](size_t, size_t begin, size_t end) {
+                for (size_t i{begin}; i < end; ++i) {
+                  gathered[i] = (*inputs[sources[i]])[positions[i]];
+                }
+              });
+          Column<T> merged(std::move(gathered));
+          merged.inherit(column);
+          df.columns[column_name] = std::move(merged);
+        },
+        first.columns.at(column_name));
+  }
+
+  df.rows = total;
+  df.cols = df.column_info.size();
+
+  return df;
+}
+
 // =====================================
 // join methods
 // =====================================
@@ -803,53 +983,30 @@ DataFrame DataFrame::inner_join(const DataFrame& left, const DataFrame& right,
   left.validate_subset(on);
   right.validate_subset(on);
 
-  auto [all_column_names, right_only_column_names, result] =
-      setup_join(left, right, on, left.nrows());
+  std::vector<uint64_t> left_hashes{compute_row_hashes(left, on)};
+  std::vector<uint64_t> right_hashes{compute_row_hashes(right, on)};
+  std::unordered_map<uint64_t, std::vector<size_t>> hashes{
+      build_row_hash_map(right_hashes)};
 
-  std::unordered_map<size_t, std::vector<Row>> hashes{
-      build_row_hash_map(right, on)};
+  // sideways filter, the bloom pass drops most misses and the map lookup
+  // below is the only exact probe a surviving row pays for
+  std::vector<size_t> candidates{
+      bloom_row_hashes(left_hashes, right_hashes, hashes.size())};
 
-  auto append_left = [&](size_t i) {
-    for (const auto& column_name : left.column_names()) {
-      const ColumnVariant* left_col{left.get_column(column_name)};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            T value = column[i];
-            std::get<Column<T>>(result[column_name]).append(value);
-          },
-          *left_col);
-    }
-  };
-
-  auto append_right = [&](const Row& row) {
-    for (const auto& column_name : right_only_column_names) {
-      std::visit(
-          [&](auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            T value{row.at<T>(column_name)};
-            std::get<Column<T>>(result[column_name]).append(value);
-          },
-          result[column_name]);
-    }
-  };
-
-  size_t total_rows{};
-  for (size_t i{}; i < left.nrows(); ++i) {
-    size_t row_hash{compute_row_hash(left, i, on)};
-    auto it{hashes.find(row_hash)};
+  std::vector<size_t> left_rows{};
+  std::vector<size_t> right_rows{};
+  for (const auto& i : candidates) {
+    auto it{hashes.find(left_hashes[i])};
 
     if (it != hashes.end()) {
-      total_rows += it->second.size();
-      for (const Row& right_row : it->second) {
-        append_left(i);
-        append_right(right_row);
+      for (const auto& j : it->second) {
+        left_rows.push_back(i);
+        right_rows.push_back(j);
       }
     }
   }
 
-  return DataFrame(total_rows, all_column_names.size(), all_column_names,
-                   result);
+  return gather_join(left, right, left_rows, right_rows, on);
 }
 
 DataFrame DataFrame::left_join(const DataFrame& left, const DataFrame& right,
@@ -857,59 +1014,30 @@ DataFrame DataFrame::left_join(const DataFrame& left, const DataFrame& right,
   left.validate_subset(on);
   right.validate_subset(on);
 
-  auto [all_column_names, right_only_column_names, result] =
-      setup_join(left, right, on, left.nrows());
-
-  std::unordered_map<size_t, std::vector<Row>> hashes{
-      build_row_hash_map(right, on)};
+  std::vector<uint64_t> left_hashes{compute_row_hashes(left, on)};
+  std::unordered_map<uint64_t, std::vector<size_t>> hashes{
+      build_row_hash_map(compute_row_hashes(right, on))};
 
-  auto append_left = [&](size_t i) {
-    for (const auto& column_name : left.column_names()) {
-      const ColumnVariant* left_col{left.get_column(column_name)};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            std::get<Column<T>>(result[column_name]).append(column[i]);
-          },
-          *left_col);
-    }
-  };
+  std::vector<size_t> left_rows{};
+  std::vector<size_t> right_rows{};
+  left_rows.reserve(left.nrows());
+  right_rows.reserve(left.nrows());
 
-  auto append_right = [&](const Row* row) {
-    for (const auto& column_name : right_only_column_names) {
-      std::visit(
-          [&](auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            if (row != nullptr) {
-              column.append(row->at<T>(column_name));
-            } else {
-              column.append(utils::get_null<T>());
-            }
-          },
-          result[column_name]);
-    }
-  };
-
-  size_t total_rows{};
   for (size_t i{}; i < left.nrows(); ++i) {
-    size_t row_hash{compute_row_hash(left, i, on)};
-    auto it{hashes.find(row_hash)};
+    auto it{hashes.find(left_hashes[i])};
 
     if (it != hashes.end()) {
-      total_rows += it->second.size();
-      for (const Row& right_row : it->second) {
-        append_left(i);
-        append_right(&right_row);
+      for (const auto& j : it->second) {
+        left_rows.push_back(i);
+        right_rows.push_back(j);
       }
-    } else {  // append nulls for right
-      ++total_rows;
-      append_left(i);
-      append_right(nullptr);
+    } else {  // nulls for right
+      left_rows.push_back(i);
+      right_rows.push_back(dispatch::npos);
     }
   }
 
-  return DataFrame(total_rows, all_column_names.size(), all_column_names,
-                   result);
+  return gather_join(left, right, left_rows, right_rows, on);
 }
 
 DataFrame DataFrame::right_join(const DataFrame& left, const DataFrame& right,
@@ -922,79 +1050,40 @@ DataFrame DataFrame::full_join(const DataFrame& left, const DataFrame& right,
   left.validate_subset(on);
   right.validate_subset(on);
 
-  auto [all_column_names, right_only_column_names, result] =
-      setup_join(left, right, on, (right.nrows() * left.nrows()));
+  std::vector<uint64_t> left_hashes{compute_row_hashes(left, on)};
+  std::unordered_map<uint64_t, std::vector<size_t>> hashes{
+      build_row_hash_map(compute_row_hashes(right, on))};
+  std::unordered_set<uint64_t> matched_rows{};
 
-  std::unordered_map<size_t, std::vector<Row>> hashes{
-      build_row_hash_map(right, on)};
-  std::unordered_set<size_t> matched_rows{};
+  std::vector<size_t> left_rows{};
+  std::vector<size_t> right_rows{};
 
-  auto append_from_df = [&](const DataFrame& df, size_t i,
-                            const std::vector<std::string>& column_names) {
-    for (const auto& column_name : column_names) {
-      const ColumnVariant* col{df.get_column(column_name)};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            std::get<Column<T>>(result[column_name]).append(column[i]);
-          },
-          *col);
-    }
-  };
-
-  auto append_from_row = [&](const Row& row,
-                             const std::vector<std::string>& column_names) {
-    for (const auto& column_name : column_names) {
-      std::visit(
-          [&](auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            column.append(row.at<T>(column_name));
-          },
-          result[column_name]);
-    }
-  };
-
-  auto append_nulls = [&](const std::vector<std::string>& column_names) {
-    for (const auto& column_name : column_names) {
-      std::visit(
-          [&](auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            column.append(utils::get_null<T>());
-          },
-          result[column_name]);
-    }
-  };
-
-  size_t total_rows{};
   for (size_t i{}; i < left.nrows(); ++i) {
-    size_t row_hash{compute_row_hash(left, i, on)};
+    uint64_t row_hash{left_hashes[i]};
     auto it{hashes.find(row_hash)};
     if (it != hashes.end()) {
-      total_rows += it->second.size();
-      for (const Row& right_row : it->second) {
-        append_from_df(left, i, left.column_names());
-        append_from_row(right_row, right_only_column_names);
+      for (const auto& j : it->second) {
+        left_rows.push_back(i);
+        right_rows.push_back(j);
       }
       matched_rows.insert(row_hash);
     } else {
-      append_from_df(left, i, left.column_names());
-      append_nulls(right_only_column_names);
-      ++total_rows;
+      left_rows.push_back(i);
+      right_rows.push_back(dispatch::npos);
     }
   }
 
+  // unmatched right rows, with nulls for every left column
   for (const auto& [row_hash, rows] : hashes) {
     if (!matched_rows.contains(row_hash)) {
-      total_rows += rows.size();
-      for (const Row& row : rows) {
-        append_nulls(left.column_names());
-        append_from_row(row, right_only_column_names);
+      for (const auto& j : rows) {
+        left_rows.push_back(dispatch::npos);
+        right_rows.push_back(j);
       }
     }
   }
 
-  return DataFrame(total_rows, all_column_names.size(), all_column_names,
-                   result);
+  return gather_join(left, right, left_rows, right_rows, on);
 }
 
 DataFrame DataFrame::anti_join(const DataFrame& df, const DataFrame& other,
@@ -1002,41 +1091,314 @@ DataFrame DataFrame::anti_join(const DataFrame& df, const DataFrame& other,
   df.validate_subset(on);
   other.validate_subset(on);
 
-  const auto& column_names{df.column_names()};
+  std::vector<uint64_t> other_hashes{compute_row_hashes(other, on)};
+  FlatHashSet<uint64_t, IdentityHash> keys{other_hashes.size()};
+  for (const auto& h : other_hashes) {
+    keys.insert(h);
+  }
 
-  std::unordered_map<std::string, ColumnVariant> result{};
-  for (const auto& column_name : column_names) {
-    const ColumnVariant* col{df.get_column(column_name)};
-    std::visit(
-        [&](const auto& column) {
-          using T = std::decay_t<decltype(column)>::value_type;
-          result[column_name] = Column<T>(df.nrows());
-        },
-        *col);
+  std::vector<uint64_t> df_hashes{compute_row_hashes(df, on)};
+  std::vector<size_t> selection{};
+  for (size_t i{}; i < df.nrows(); ++i) {
+    if (!keys.contains(df_hashes[i])) {
+      selection.push_back(i);
+    }
   }
 
-  std::unordered_map<size_t, std::vector<Row>> hashes{
-      build_row_hash_map(other, on)};
+  return df.take(selection);
+}
 
-  size_t total_rows{};
-  for (size_t i{}; i < df.nrows(); ++i) {
-    size_t row_hash{compute_row_hash(df, i, on)};
-    auto it{hashes.find(row_hash)};
-    if (it == hashes.end()) {
-      for (const auto& column_name : column_names) {
-        const ColumnVariant* col{df.get_column(column_name)};
-        std::visit(
-            [&](const auto& column) {
-              using T = std::decay_t<decltype(column)>::value_type;
-              std::get<Column<T>>(result[column_name]).append(column[i]);
-            },
-            *col);
+DataFrame DataFrame::semi_join(const DataFrame& df, const DataFrame& other,
+                               const std::vector<std::string>& on) {
+  df.validate_subset(on);
+  other.validate_subset(on);
+
+  std::vector<uint64_t> df_hashes{compute_row_hashes(df, on)};
+  std::vector<uint64_t> other_hashes{compute_row_hashes(other, on)};
+
+  return df.take(probe_row_hashes(df_hashes, other_hashes));
+}
+
+// every right row with left_on - before <= right_on <= left_on + after
+DataFrame DataFrame::band_join(const DataFrame& left, const DataFrame& right,
+                               const std::string& left_on,
+                               const std::string& right_on, double before,
+                               double after,
+                               const std::vector<std::string>& by) {
+  if (!std::isfinite(before) || !std::isfinite(after) || before < 0.0 ||
+      after < 0.0) {
+    throw std::invalid_argument("band widths must be finite and non negative");
+  }
+  return range_join(left, right, left_on, left_on, right_on, before, after,
+                    by);
+}
+
+// every right row with start <= right_on <= end
+DataFrame DataFrame::interval_join(const DataFrame& left,
+                                   const DataFrame& right,
+                                   const std::string& start,
+                                   const std::string& end,
+                                   const std::string& right_on,
+                                   const std::vector<std::string>& by) {
+  return range_join(left, right, start, end, right_on, 0.0, 0.0, by);
+}
+
+// =====================================
+// grouping methods
+// =====================================
+
+GroupBy DataFrame::groupby(const std::vector<std::string>& by) const {
+  return GroupBy(*this, by);
+}
+
+// =====================================
+// reshaping methods
+// =====================================
+
+/*
+NOTE: index and column values are numbered densely by hashing, which fixes
+the output shape before any data moves. every output column is allocated
+null filled at its final size and the values are scattered into place,
+rows with a null column value are dropped
+*/
+DataFrame DataFrame::pivot(const std::string& index, const std::string& column,
+                           const std::string& values) const {
+  validate_subset({index, column, values});
+
+  GroupBy row_groups{*this, {index}};
+  GroupBy column_groups{*this, {column}};
+  const std::vector<size_t>& row_ids{row_groups.get_group_ids()};
+  const std::vector<size_t>& column_ids{column_groups.get_group_ids()};
+  const size_t nrows{row_groups.ngroups()};
+
+  constexpr size_t no_slot{std::numeric_limits<size_t>::max()};
+  std::vector<size_t> slots(column_groups.ngroups(), no_slot);
+  std::vector<std::string> names{};
+
+  std::visit(
+      [&](const auto& col) {
+        using T = std::decay_t<decltype(col)>::value_type;
+        for (size_t g{}; g < slots.size(); ++g) {
+          const T& value{col.data[column_groups.get_first_rows()[g]]};
+          if (utils::is_null(value)) {
+            continue;
+          }
+
+          std::ostringstream name{};
+          name << std::setprecision(17) << value;
+          if (name.str() == index) {
+            throw std::invalid_argument("pivot column collides with index: " +
+                                        index);
+          }
+          slots[g] = names.size();
+          names.push_back(name.str());
+        }
+      },
+      columns.at(column));
+
+  std::vector<uint8_t> filled(nrows * names.size(), 0);
+  for (size_t i{}; i < rows; ++i) {
+    size_t slot{slots[column_ids[i]]};
+    if (slot == no_slot) {
+      continue;
+    }
+    uint8_t& cell{filled[row_ids[i] * names.size() + slot]};
+    if (cell) {
+      throw std::invalid_argument("duplicate entries for pivot");
+    }
+    cell = 1;
+  }
+
+  DataFrame df{take(row_groups.get_first_rows()).select({index})};
+
+  std::visit(
+      [&](const auto& col) {
+        using T = std::decay_t<decltype(col)>::value_type;
+        std::vector<std::vector<T>> outputs(
+            names.size(), std::vector<T>(nrows, utils::get_null<T>()));
+
+        // cells are unique, so chunks never write to the same element
+        parallel::for_chunks(rows, 1 << 16, [&](size_t, size_t begin,
+                                                size_t end) {
+          for (size_t i{begin}; i < end; ++i) {
+            size_t slot{slots[column_ids[i]]};
+            if (slot != no_slot) {
+              outputs[slot][row_ids[i]] = col.data[i];
+            }
+          }
+        });
+
+        for (size_t k{}; k < names.size(); ++k) {
+          Column<T> pivoted(std::move(outputs[k]));
+          pivoted.inherit(col);
+          df.column_info.push_back(names[k]);
+          df.columns[names[k]] = std::move(pivoted);
+        }
+      },
+      columns.at(values));
+
+  df.cols = df.column_info.size();
+
+  return df;
+}
+
+/*
+NOTE: the output has one block of rows per value column, in order. id
+columns are repeated block by block and every output column is gathered
+into its final size in parallel
+*/
+DataFrame DataFrame::melt(const std::vector<std::string>& id_vars,
+                          const std::vector<std::string>& value_vars,
+                          const std::string& var_name,
+                          const std::string& value_name) const {
+  validate_subset(id_vars);
+
+  std::vector<std::string> melted{value_vars};
+  if (melted.empty()) {
+    for (const auto& name : column_info) {
+      if (std::ranges::find(id_vars, name) == id_vars.end()) {
+        melted.push_back(name);
       }
-      ++total_rows;
     }
   }
+  if (melted.empty()) {
+    throw std::invalid_argument("no columns indicated for melting");
+  }
+  validate_subset(melted);
+
+  if (var_name == value_name ||
+      std::ranges::find(id_vars, var_name) != id_vars.end() ||
+      std::ranges::find(id_vars, value_name) != id_vars.end()) {
+    throw std::invalid_argument("melt output names must be unique");
+  }
+
+  const size_t type{columns.at(melted.front()).index()};
+  for (const auto& name : melted) {
+    if (columns.at(name).index() != type) {
+      throw std::invalid_argument("melted columns must share a type");
+    }
+  }
+
+  const size_t blocks{melted.size()};
+  const size_t total{rows * blocks};
+
+  // func(begin, end, block, offset) fills output rows [begin, end), which
+  // lie in one block and start at source row offset
+  auto gather = [&](auto func) {
+    parallel::for_chunks(total, 1 << 16, [&](size_t, size_t begin,
+                                             size_t end) {
+      for (size_t j{begin}; j < end;) {
+        size_t block{j / rows};
+        size_t stop{std::min(end, (block + 1) * rows)};
+        func(j, stop, block, j - block * rows);
+        j = stop;
+      }
+    });
+  };
+
+  DataFrame df{};
+
+  for (const auto& name : id_vars) {
+    std::visit(
+        [&](const auto& col) {
+          using T = std::decay_t<decltype(col)>::value_type;
+          std::vector<T> out(total);
+          gather([&](size_t begin, size_t end, size_t, size_t offset) {
+            std::copy_n(col.data.begin() + offset, end - begin,
+                        out.begin() + begin);
+          });
+          Column<T> repeated(std::move(out));
+          repeated.inherit(col);
+          df.column_info.push_back(name);
+          df.columns[name] = std::move(repeated);
+        },
+        columns.at(name));
+  }
+
+  std::vector<std::string> variables(total);
+  gather([&](size_t begin, size_t end, size_t block, size_t) {
+    std::fill(variables.begin() + begin, variables.begin() + end,
+              melted[block]);
+  });
+  df.column_info.push_back(var_name);
+  df.columns[var_name] = Column<std::string>(std::move(variables));
+
+  std::visit(
+      [&](const auto& first) {
+        using T = std::decay_t<decltype(first)>::value_type;
+        std::vector<const std::vector<T>*> sources{};
+        for (const auto& name : melted) {
+          sources.push_back(&std::get<Column<T>>(columns.at(name)).data);
+        }
+
+        std::vector<T> out(total);
+        gather([&](size_t begin, size_t end, size_t block, size_t offset) {
+          std::copy_n(sources[block]->begin() + offset, end - begin,
+                      out.begin() + begin);
+        });
+        Column<T> stacked(std::move(out));
+        stacked.inherit(first);
+        df.column_info.push_back(value_name);
+        df.columns[value_name] = std::move(stacked);
+      },
+      columns.at(melted.front()));
+
+  df.rows = total;
+  df.cols = df.column_info.size();
+
+  return df;
+}
+
+// =====================================
+// window methods
+// =====================================
 
-  return DataFrame(total_rows, column_names.size(), column_names, result);
+DataFrame& DataFrame::row_number(const std::vector<std::string>& partition_by,
+                                 const std::string& order_by,
+                                 const std::string& output, bool ascending) {
+  return ranking(partition_by, order_by, output, ascending, Ranking::RowNumber);
+}
+
+DataFrame& DataFrame::rank(const std::vector<std::string>& partition_by,
+                           const std::string& order_by,
+                           const std::string& output, bool ascending) {
+  return ranking(partition_by, order_by, output, ascending, Ranking::Rank);
+}
+
+DataFrame& DataFrame::dense_rank(const std::vector<std::string>& partition_by,
+                                 const std::string& order_by,
+                                 const std::string& output, bool ascending) {
+  return ranking(partition_by, order_by, output, ascending, Ranking::DenseRank);
+}
+
+DataFrame& DataFrame::lag(const std::string& column_name, size_t offset,
+                          const std::vector<std::string>& partition_by,
+                          const std::string& order_by,
+                          const std::string& output) {
+  return shift_within(column_name, -static_cast<int64_t>(offset), partition_by,
+                      order_by, output);
+}
+
+DataFrame& DataFrame::lead(const std::string& column_name, size_t offset,
+                           const std::vector<std::string>& partition_by,
+                           const std::string& order_by,
+                           const std::string& output) {
+  return shift_within(column_name, static_cast<int64_t>(offset), partition_by,
+                      order_by, output);
+}
+
+DataFrame& DataFrame::first_value(const std::string& column_name,
+                                  const std::vector<std::string>& partition_by,
+                                  const std::string& order_by,
+                                  const std::string& output) {
+  return edge_value(column_name, true, partition_by, order_by, output);
+}
+
+DataFrame& DataFrame::last_value(const std::string& column_name,
+                                 const std::vector<std::string>& partition_by,
+                                 const std::string& order_by,
+                                 const std::string& output) {
+  return edge_value(column_name, false, partition_by, order_by, output);
 }
 
 // =====================================
@@ -1120,6 +1482,115 @@ double DataFrame::variance(const std::string& column_name) const {
       column_name, [](const auto& col) { return col.variance(); });
 }
 
+size_t DataFrame::nunique(const std::string& column_name) const {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+  return std::visit([](const auto& col) { return col.nunique(); },
+                    it->second);
+}
+
+DataFrame DataFrame::cov(NullHandling nulls) const {
+  return covariance_matrix(nulls, false);
+}
+
+DataFrame DataFrame::corr(NullHandling nulls) const {
+  return covariance_matrix(nulls, true);
+}
+
+DataFrame& DataFrame::cut(const std::string& column_name,
+                          const std::vector<double>& edges,
+                          const std::string& output) {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  Column<int64_t> codes{std::visit(
+      [&](const auto& col) { return col.cut(edges); }, it->second)};
+  add_column<int64_t>(output, std::move(codes.data));
+
+  return *this;
+}
+
+DataFrame& DataFrame::qcut(const std::string& column_name, size_t quantiles,
+                           const std::string& output) {
+  auto it{columns.find(column_name)};
+  if (it == columns.end()) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  Column<int64_t> codes{std::visit(
+      [&](const auto& col) { return col.qcut(quantiles); }, it->second)};
+  add_column<int64_t>(output, std::move(codes.data));
+
+  return *this;
+}
+
+// =====================================
+// time-series methods
+// =====================================
+
+DataFrame& DataFrame::rolling(const std::string& x, const std::string& y,
+                              RollingStat stat, size_t window,
+                              const std::string& output,
+                              const std::vector<std::string>& by,
+                              size_t min_periods) {
+  if (window == 0) {
+    throw std::invalid_argument("rolling window must be positive");
+  }
+
+  const std::vector<double>& xs{double_values(x)};
+  const std::vector<double>& ys{double_values(y)};
+  std::vector<std::vector<size_t>> partitions{partition_rows(by)};
+
+  std::vector<double> result(rows, utils::get_null<double>());
+  parallel::for_chunks(partitions.size(), 1,
+                       [&](size_t, size_t begin, size_t end) {
+                         for (size_t p{begin}; p < end; ++p) {
+                           rolling::by_rows(xs, ys, partitions[p], window,
+                                            min_periods, stat, result);
+                         }
+                       });
+
+  add_column<double>(output, std::move(result));
+  return *this;
+}
+
+DataFrame& DataFrame::rolling(const std::string& x, const std::string& y,
+                              RollingStat stat, const std::string& time_column,
+                              int64_t duration, const std::string& output,
+                              const std::vector<std::string>& by,
+                              size_t min_periods) {
+  if (duration <= 0) {
+    throw std::invalid_argument("rolling duration must be positive");
+  }
+
+  const Column<int64_t>* times{get_column<int64_t>(time_column)};
+  if (times == nullptr) {
+    throw std::invalid_argument(
+        "time column must be an existing int64 column: " + time_column);
+  }
+
+  const std::vector<double>& xs{double_values(x)};
+  const std::vector<double>& ys{double_values(y)};
+  std::vector<std::vector<size_t>> partitions{partition_rows(by)};
+
+  std::vector<double> result(rows, utils::get_null<double>());
+  parallel::for_chunks(partitions.size(), 1,
+                       [&](size_t, size_t begin, size_t end) {
+                         for (size_t p{begin}; p < end; ++p) {
+                           rolling::by_time(xs, ys, times->data, partitions[p],
+                                            duration, min_periods, stat,
+                                            result);
+                         }
+                       });
+
+  add_column<double>(output, std::move(result));
+  return *this;
+}
+
 // =====================================
 // display methods
 // =====================================
@@ -1247,22 +1718,7 @@ void DataFrame::compact_rows(const std::vector<size_t>& removal_indices) {
   }
 
   for (auto& [_, col] : columns) {
-    std::visit(
-        [&](auto& c) {
-          auto shifter = [&](auto& column) {
-            size_t write_position{};
-            for (size_t i{0}; i < column.nrows(); ++i) {
-              if (remove[i] == false) {
-                column[write_position++] = std::move(column[i]);
-              }
-            }
-
-            column.resize(write_position);
-          };
-
-          shifter(c);
-        },
-        col);
+    std::visit([&](auto& column) { column.compact(remove); }, col);
   }
 
   rows -= removal_indices.size();
@@ -1356,76 +1812,649 @@ void DataFrame::validate_subset(const std::vector<std::string>& subset) const {
   }
 }
 
-void DataFrame::combine_hash(size_t& row_hash, size_t value_hash) {
-  row_hash ^= value_hash + 0x9e3779b9 + (row_hash << 6) + (row_hash >> 2);
-}
-
-size_t DataFrame::compute_row_hash(const DataFrame& df, size_t index,
-                                   const std::vector<std::string>& on) {
-  size_t row_hash{};
+std::vector<uint64_t> DataFrame::compute_row_hashes(
+    const DataFrame& df, const std::vector<std::string>& on) {
+  std::vector<uint64_t> row_hashes(df.nrows(), hash::seed);
   for (const auto& column_name : on) {
     const ColumnVariant* col{df.get_column(column_name)};
     std::visit(
-        [&](const auto& column) {
-          using T = std::decay_t<decltype(column)>::value_type;
-          combine_hash(row_hash, std::hash<T>{}(column[index]));
-        },
+        [&](const auto& column) { column.combine_hash_into(row_hashes); },
         *col);
   }
-  return row_hash;
+  return row_hashes;
 }
 
-std::unordered_map<size_t, std::vector<Row>> DataFrame::build_row_hash_map(
-    const DataFrame& df, const std::vector<std::string>& on) {
-  std::unordered_map<size_t, std::vector<Row>> hashes{};
-  for (size_t i{}; i < df.nrows(); ++i) {
-    size_t row_hash{compute_row_hash(df, i, on)};
-    hashes[row_hash].push_back(df.get_row(i));
+// row indices by row hash, each list ascending
+std::unordered_map<uint64_t, std::vector<size_t>> DataFrame::build_row_hash_map(
+    const std::vector<uint64_t>& row_hashes) {
+  std::unordered_map<uint64_t, std::vector<size_t>> hashes{};
+  hashes.reserve(row_hashes.size());
+  for (size_t i{}; i < row_hashes.size(); ++i) {
+    hashes[row_hashes[i]].push_back(i);
   }
 
   return hashes;
 }
 
-std::tuple<std::vector<std::string>, std::vector<std::string>,
-           std::unordered_map<std::string, ColumnVariant>>
-DataFrame::setup_join(const DataFrame& left, const DataFrame& right,
-                      const std::vector<std::string>& on, size_t size) {
-  std::vector<std::string> all_names{};
-  std::vector<std::string>
-      right_names{};  // to easily access which values to append
-  std::unordered_map<std::string, ColumnVariant> result{};
+// probe rows that may have a match among keys distinct build hashes
+std::vector<size_t> DataFrame::bloom_row_hashes(
+    const std::vector<uint64_t>& probe, const std::vector<uint64_t>& build,
+    size_t keys) {
+  std::vector<size_t> selection(probe.size());
+  if (keys <= BloomFilter::min_keys) {
+    std::iota(selection.begin(), selection.end(), size_t{});
+    return selection;
+  }
+
+  // most probe rows miss on selective joins, the bloom pass rejects them
+  // without touching the larger hash table
+  BloomFilter bloom{keys};
+  for (const auto& h : build) {
+    bloom.insert(h);
+  }
+  std::vector<uint8_t> candidates(probe.size());
+  bloom.might_contain(probe.data(), probe.size(), candidates.data());
+
+  selection.clear();
+  for (size_t i{}; i < probe.size(); ++i) {
+    if (candidates[i]) {
+      selection.push_back(i);
+    }
+  }
+
+  return selection;
+}
+
+std::vector<size_t> DataFrame::probe_row_hashes(
+    const std::vector<uint64_t>& probe, const std::vector<uint64_t>& build) {
+  FlatHashSet<uint64_t, IdentityHash> keys{build.size()};
+  for (const auto& h : build) {
+    keys.insert(h);
+  }
 
-  // initialize left df columns
-  for (const auto& column_name : left.column_names()) {
-    all_names.push_back(column_name);
-    const ColumnVariant* col{left.get_column(column_name)};
+  std::vector<size_t> selection{};
+  for (const auto& i : bloom_row_hashes(probe, build, keys.size())) {
+    if (keys.contains(probe[i])) {
+      selection.push_back(i);
+    }
+  }
+
+  return selection;
+}
+
+/*
+NOTE: output of every join, left columns gathered by left_rows, then the
+right columns not in skip by right_rows. npos rows are null, each column is
+resolved once and gathered whole. a right name already taken gets a
+_right suffix
+*/
+DataFrame DataFrame::gather_join(const DataFrame& left, const DataFrame& right,
+                                 const std::vector<size_t>& left_rows,
+                                 const std::vector<size_t>& right_rows,
+                                 const std::vector<std::string>& skip) {
+  DataFrame result{};
+  result.column_info = left.column_info;
+  for (const auto& column_name : left.column_info) {
+    dispatch::run<dispatch::Gather>(left.columns.at(column_name), left_rows,
+                                    result.columns[column_name]);
+  }
+
+  for (const auto& column_name : right.column_info) {
+    if (std::ranges::find(skip, column_name) != skip.end()) {
+      continue;
+    }
+
+    std::string name{column_name};
+    if (result.has_column(name)) {
+      name += "_right";
+    }
+    if (result.has_column(name)) {
+      throw std::invalid_argument("duplicate column name in join: " + name);
+    }
+
+    result.column_info.push_back(name);
+    dispatch::run<dispatch::Gather>(right.columns.at(column_name), right_rows,
+                                    result.columns[name]);
+  }
+
+  result.rows = left_rows.size();
+  result.cols = result.column_info.size();
+  return result;
+}
+
+/*
+NOTE: entries with fewer than two rows, and correlations against a zero
+variance column, are null. the first column holds the input names under
+"column", suffixed with _label while that clashes with an input name
+*/
+DataFrame DataFrame::covariance_matrix(NullHandling nulls,
+                                       bool normalize) const {
+  std::vector<std::string> names{};
+  std::vector<const ColumnVariant*> targets{};
+  bool any_null{false};
+
+  for (const auto& column_name : column_info) {
+    const auto& col{columns.at(column_name)};
     std::visit(
         [&](const auto& column) {
           using T = std::decay_t<decltype(column)>::value_type;
-          result[column_name] =
-              Column<T>{size};  // initializes columns with approx size
+          if constexpr (std::is_arithmetic_v<T>) {
+            names.push_back(column_name);
+            targets.push_back(&col);
+            any_null = any_null || column.get_null_count() > 0;
+          }
         },
-        *col);
+        col);
   }
 
-  // initialize right df columns
-  for (const auto& column_name : right.column_names()) {
-    auto it{std::ranges::find(on, column_name)};
-    if (it == on.end()) {
-      all_names.push_back(column_name);
-      right_names.push_back(column_name);
-      const ColumnVariant* col{right.get_column(column_name)};
-      std::visit(
-          [&](const auto& column) {
-            using T = std::decay_t<decltype(column)>::value_type;
-            result[column_name] =
-                Column<T>{size};  // initializes columns with approx size
-          },
-          *col);
+  if (names.empty()) {
+    throw std::invalid_argument("no numerical columns for covariance");
+  }
+
+  const size_t k{names.size()};
+
+  // column major values with nulls zeroed, plus a 0 / 1 validity mask
+  std::vector<uint8_t> keep(rows, 1);
+  std::vector<double> values(rows * k);
+  std::vector<double> mask(rows * k);
+  for (size_t c{}; c < k; ++c) {
+    std::visit(
+        [&](const auto& column) {
+          using T = std::decay_t<decltype(column)>::value_type;
+          if constexpr (std::is_arithmetic_v<T>) {
+            for (size_t r{}; r < rows; ++r) {
+              bool valid{!utils::is_null(column.data[r])};
+              values[c * rows + r] =
+                  valid ? static_cast<double>(column.data[r]) : 0.0;
+              mask[c * rows + r] = valid;
+              keep[r] &= valid;
+            }
+          }
+        },
+        *targets[c]);
+  }
+
+  size_t n{rows};
+  if (nulls == NullHandling::CompleteRows && any_null) {
+    n = 0;
+    for (size_t r{}; r < rows; ++r) {
+      if (keep[r]) {
+        for (size_t c{}; c < k; ++c) {
+          values[c * rows + n] = values[c * rows + r];
+        }
+        ++n;
+      }
+    }
+
+    // repack densely as n x k
+    for (size_t c{1}; c < k; ++c) {
+      std::copy_n(values.begin() + c * rows, n, values.begin() + c * n);
     }
+    values.resize(n * k);
+    any_null = false;
+  }
+
+  // center every column once on the mean of its own valid values
+  for (size_t c{}; c < k; ++c) {
+    double* column{values.data() + c * n};
+    const double* valid{any_null ? mask.data() + c * rows : nullptr};
+    reduce::Accumulator total{};
+    for (size_t r{}; r < n; ++r) {
+      if (valid == nullptr || valid[r] != 0.0) {
+        total.add(column[r]);
+        ++total.count;
+      }
+    }
+
+    double mu{total.count > 0 ? total.result() / total.count : 0.0};
+    for (size_t r{}; r < n; ++r) {
+      if (valid == nullptr || valid[r] != 0.0) {
+        column[r] -= mu;
+      }
+    }
+  }
+
+  std::vector<double> result(k * k, utils::get_null<double>());
+  std::vector<double> cross{linalg::gram(values, k, values, k, n)};
+
+  if (!any_null) {
+    for (size_t i{}; i < k; ++i) {
+      for (size_t j{}; j < k; ++j) {
+        if (n > 1) {
+          result[i * k + j] = cross[i * k + j] / (n - 1);
+        }
+      }
+    }
+
+    if (normalize) {
+      std::vector<double> variances(k);
+      for (size_t i{}; i < k; ++i) {
+        variances[i] = result[i * k + i];
+      }
+      for (size_t i{}; i < k; ++i) {
+        for (size_t j{}; j < k; ++j) {
+          double scale{variances[i] * variances[j]};
+          if (n > 1) {
+            result[i * k + j] = scale > 0.0
+                                    ? result[i * k + j] / std::sqrt(scale)
+                                    : utils::get_null<double>();
+          }
+        }
+      }
+    }
+  } else {
+    /*
+    pairwise, every sum restricted to rows where both columns are valid
+    is itself a gram product against the mask:
+      sums[i][j]    = sum x_i m_j     squares[i][j] = sum x_i^2 m_j
+      counts[i][j]  = sum m_i m_j
+    */
+    std::vector<double> squared(values.size());
+    for (size_t i{}; i < values.size(); ++i) {
+      squared[i] = values[i] * values[i];
+    }
+
+    std::vector<double> sums{linalg::gram(values, k, mask, k, n)};
+    std::vector<double> squares{linalg::gram(squared, k, mask, k, n)};
+    std::vector<double> counts{linalg::gram(mask, k, mask, k, n)};
+
+    for (size_t i{}; i < k; ++i) {
+      for (size_t j{}; j < k; ++j) {
+        double m{counts[i * k + j]};
+        if (m < 2.0) {
+          continue;
+        }
+
+        double si{sums[i * k + j]};
+        double sj{sums[j * k + i]};
+        double covariance{(cross[i * k + j] - si * sj / m) / (m - 1.0)};
+
+        if (normalize) {
+          double vi{(squares[i * k + j] - si * si / m) / (m - 1.0)};
+          double vj{(squares[j * k + i] - sj * sj / m) / (m - 1.0)};
+          if (vi * vj > 0.0) {
+            result[i * k + j] = covariance / std::sqrt(vi * vj);
+          }
+        } else {
+          result[i * k + j] = covariance;
+        }
+      }
+    }
+  }
+
+  std::string label{"column"};
+  while (std::ranges::find(names, label) != names.end()) {
+    label += "_label";
+  }
+
+  DataFrame df{};
+  df.add_column<std::string>(label, names);
+  for (size_t j{}; j < k; ++j) {
+    std::vector<double> column(k);
+    for (size_t i{}; i < k; ++i) {
+      column[i] = result[i * k + j];
+    }
+    df.add_column<double>(names[j], column);
   }
 
-  return {all_names, right_names, result};
+  return df;
+}
+
+std::vector<std::vector<size_t>> DataFrame::partition_rows(
+    const std::vector<std::string>& by) const {
+  if (by.empty()) {
+    std::vector<size_t> all(rows);
+    std::iota(all.begin(), all.end(), size_t{0});
+    return {std::move(all)};
+  }
+
+  GroupBy groups{*this, by};
+  const std::vector<size_t>& ids{groups.get_group_ids()};
+
+  std::vector<std::vector<size_t>> partitions(groups.ngroups());
+  for (size_t i{}; i < rows; ++i) {
+    partitions[ids[i]].push_back(i);
+  }
+  return partitions;
+}
+
+const std::vector<double>& DataFrame::double_values(
+    const std::string& column_name) const {
+  const Column<double>* col{get_column<double>(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column must be an existing double column: " +
+                                column_name);
+  }
+  return col->data;
+}
+
+/*
+NOTE: partitions are found once by hashing, then each one is stably sorted
+on order_by with the column type resolved outside the comparator. an empty
+order_by keeps row order. partitions are sorted in parallel
+*/
+std::vector<std::vector<size_t>> DataFrame::ordered_partitions(
+    const std::vector<std::string>& partition_by, const std::string& order_by,
+    bool ascending) const {
+  std::vector<std::vector<size_t>> partitions{partition_rows(partition_by)};
+  if (order_by.empty()) {
+    return partitions;
+  }
+
+  const ColumnVariant* target{get_column(order_by)};
+  if (target == nullptr) {
+    throw std::invalid_argument("column not found: " + order_by);
+  }
+
+  std::visit(
+      [&](const auto& column) {
+        const auto& values{column.data};
+        parallel::for_chunks(
+            partitions.size(), 1, [&](size_t, size_t begin, size_t end) {
+              for (size_t p{begin}; p < end; ++p) {
+                std::ranges::stable_sort(
+                    partitions[p], [&](size_t a, size_t b) {
+                      return ascending ? values[a] < values[b]
+                                       : values[b] < values[a];
+                    });
+              }
+            });
+      },
+      *target);
+
+  return partitions;
+}
+
+DataFrame& DataFrame::ranking(const std::vector<std::string>& partition_by,
+                              const std::string& order_by,
+                              const std::string& output, bool ascending,
+                              Ranking method) {
+  std::vector<std::vector<size_t>> partitions{
+      ordered_partitions(partition_by, order_by, ascending)};
+  std::vector<int64_t> result(rows);
+
+  auto assign = [&](const auto& values) {
+    parallel::for_chunks(
+        partitions.size(), 1, [&](size_t, size_t begin, size_t end) {
+          for (size_t p{begin}; p < end; ++p) {
+            const std::vector<size_t>& order{partitions[p]};
+            int64_t current{0};
+            for (size_t k{}; k < order.size(); ++k) {
+              bool tied{k > 0 && !(values[order[k - 1]] < values[order[k]]) &&
+                        !(values[order[k]] < values[order[k - 1]])};
+
+              if (method == Ranking::RowNumber) {
+                current = static_cast<int64_t>(k) + 1;
+              } else if (!tied) {
+                current = method == Ranking::Rank ? static_cast<int64_t>(k) + 1
+                                                  : current + 1;
+              }
+              result[order[k]] = current;
+            }
+          }
+        });
+  };
+
+  if (order_by.empty()) {
+    std::vector<size_t> positions(rows);
+    std::iota(positions.begin(), positions.end(), size_t{0});
+    assign(positions);  // row order, no ties
+  } else {
+    std::visit([&](const auto& column) { assign(column.data); },
+               *get_column(order_by));
+  }
+
+  add_column<int64_t>(output, std::move(result));
+  return *this;
+}
+
+DataFrame& DataFrame::shift_within(const std::string& column_name,
+                                   int64_t offset,
+                                   const std::vector<std::string>& partition_by,
+                                   const std::string& order_by,
+                                   const std::string& output) {
+  const ColumnVariant* target{get_column(column_name)};
+  if (target == nullptr) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  std::vector<std::vector<size_t>> partitions{
+      ordered_partitions(partition_by, order_by)};
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+        std::vector<T> result(rows, utils::get_null<T>());
+
+        parallel::for_chunks(
+            partitions.size(), 1, [&](size_t, size_t begin, size_t end) {
+              for (size_t p{begin}; p < end; ++p) {
+                const std::vector<size_t>& order{partitions[p]};
+                const int64_t n{static_cast<int64_t>(order.size())};
+                for (int64_t k{}; k < n; ++k) {
+                  int64_t source{k + offset};
+                  if (source >= 0 && source < n) {
+                    result[order[k]] = column.data[order[source]];
+                  }
+                }
+              }
+            });
+
+        add_column<T>(output, std::move(result));
+      },
+      *target);
+
+  return *this;
+}
+
+DataFrame& DataFrame::edge_value(const std::string& column_name, bool first,
+                                 const std::vector<std::string>& partition_by,
+                                 const std::string& order_by,
+                                 const std::string& output) {
+  const ColumnVariant* target{get_column(column_name)};
+  if (target == nullptr) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+
+  std::vector<std::vector<size_t>> partitions{
+      ordered_partitions(partition_by, order_by)};
+
+  // frame is the whole ordered partition
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+        std::vector<T> result(rows, utils::get_null<T>());
+
+        parallel::for_chunks(
+            partitions.size(), 1, [&](size_t, size_t begin, size_t end) {
+              for (size_t p{begin}; p < end; ++p) {
+                const std::vector<size_t>& order{partitions[p]};
+                if (order.empty()) {
+                  continue;
+                }
+
+                const T& value{
+                    column.data[first ? order.front() : order.back()]};
+                for (const auto& row : order) {
+                  result[row] = value;
+                }
+              }
+            });
+
+        add_column<T>(output, std::move(result));
+      },
+      *target);
+
+  return *this;
+}
+
+/*
+NOTE: both sides are bucketed on the by keys with the join row hashes, then
+each bucket is sorted, right on the point and left on the window start, and
+swept with a sliding window. buckets are sorted and swept in parallel. the
+matches of every left row form one contiguous run of the sorted right rows,
+so the output comes out in left row order without a final sort. nulls never
+match, right columns that clash with a left name get a _right suffix
+*/
+DataFrame DataFrame::range_join(const DataFrame& left, const DataFrame& right,
+                                const std::string& lower,
+                                const std::string& upper,
+                                const std::string& right_on, double before,
+                                double after,
+                                const std::vector<std::string>& by) {
+  left.validate_subset({lower, upper});
+  right.validate_subset({right_on});
+  left.validate_subset(by);
+  right.validate_subset(by);
+
+  std::vector<size_t> left_rows{};
+  std::vector<size_t> right_rows{};
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+        const Column<T>* lower_col{left.get_column<T>(lower)};
+        const Column<T>* upper_col{left.get_column<T>(upper)};
+        if constexpr (!std::is_arithmetic_v<T>) {
+          throw std::invalid_argument("range join columns must be numeric");
+        } else {
+          if (lower_col == nullptr || upper_col == nullptr) {
+            throw std::invalid_argument(
+                "range join columns must share a type");
+          }
+          const std::vector<T>& points{column.data};
+
+          auto probe_valid = [&](size_t i) {
+            return !utils::is_null(lower_col->data[i]) &&
+                   !utils::is_null(upper_col->data[i]);
+          };
+
+          // int bands round outward and saturate inside the non-null range
+          auto widen = [](T value, double band, bool down) -> T {
+            if constexpr (std::is_same_v<T, int64_t>) {
+              constexpr int64_t lowest{std::numeric_limits<int64_t>::min() +
+                                       1};
+              constexpr int64_t highest{std::numeric_limits<int64_t>::max()};
+              double rounded{std::ceil(band)};
+              if (rounded >= 0x1p63) {
+                return down ? lowest : highest;
+              }
+
+              int64_t step{static_cast<int64_t>(rounded)};
+              if (down) {
+                return value < lowest + step ? lowest : value - step;
+              }
+              return value > highest - step ? highest : value + step;
+            } else {
+              return down ? value - band : value + band;
+            }
+          };
+
+          // bounds only for rows that can probe, null rows never match
+          std::vector<T> lo(left.rows);
+          std::vector<T> hi(left.rows);
+          for (size_t i{}; i < left.rows; ++i) {
+            if (probe_valid(i)) {
+              lo[i] = widen(lower_col->data[i], before, true);
+              hi[i] = widen(upper_col->data[i], after, false);
+            }
+          }
+
+          // bucket ids from the right side, left rows without a bucket drop
+          std::vector<size_t> right_bucket(right.rows, 0);
+          std::vector<size_t> left_bucket(left.rows, 0);
+          size_t buckets{1};
+          constexpr size_t no_bucket{std::numeric_limits<size_t>::max()};
+
+          if (!by.empty()) {
+            std::vector<uint64_t> right_hashes{compute_row_hashes(right, by)};
+            std::vector<uint64_t> left_hashes{compute_row_hashes(left, by)};
+            FlatHashMap<uint64_t, size_t, IdentityHash> ids{};
+
+            for (size_t j{}; j < right.rows; ++j) {
+              size_t& id{ids[right_hashes[j]]};
+              if (id == 0) {
+                id = ids.size();
+              }
+              right_bucket[j] = id - 1;
+            }
+            for (size_t i{}; i < left.rows; ++i) {
+              const size_t* id{ids.find(left_hashes[i])};
+              left_bucket[i] = id != nullptr ? *id - 1 : no_bucket;
+            }
+            buckets = ids.size();
+          }
+
+          // counting sort into buckets, sorted segments share one buffer
+          auto bucket_rows = [&](const std::vector<size_t>& bucket_of,
+                                 auto valid, std::vector<size_t>& out) {
+            std::vector<size_t> offsets(buckets + 1, 0);
+            for (size_t i{}; i < bucket_of.size(); ++i) {
+              if (bucket_of[i] != no_bucket && valid(i)) {
+                ++offsets[bucket_of[i] + 1];
+              }
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            out.resize(offsets.back());
+            std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i{}; i < bucket_of.size(); ++i) {
+              if (bucket_of[i] != no_bucket && valid(i)) {
+                out[cursor[bucket_of[i]]++] = i;
+              }
+            }
+            return offsets;
+          };
+
+          std::vector<size_t> build{};
+          std::vector<size_t> probe{};
+          std::vector<size_t> build_offsets{bucket_rows(
+              right_bucket,
+              [&](size_t j) { return !utils::is_null(points[j]); }, build)};
+          std::vector<size_t> probe_offsets{
+              bucket_rows(left_bucket, probe_valid, probe)};
+
+          std::vector<std::pair<size_t, size_t>> ranges(left.rows, {0, 0});
+          parallel::for_chunks(
+              buckets, 1, [&](size_t, size_t begin, size_t end) {
+                for (size_t b{begin}; b < end; ++b) {
+                  auto build_first{build.begin() + build_offsets[b]};
+                  auto build_last{build.begin() + build_offsets[b + 1]};
+                  auto probe_first{probe.begin() + probe_offsets[b]};
+                  auto probe_last{probe.begin() + probe_offsets[b + 1]};
+
+                  std::stable_sort(build_first, build_last,
+                                   [&](size_t a, size_t c) {
+                                     return points[a] < points[c];
+                                   });
+                  std::stable_sort(
+                      probe_first, probe_last,
+                      [&](size_t a, size_t c) { return lo[a] < lo[c]; });
+
+                  sweep::match_ranges<T>(
+                      points, std::span<const size_t>(build_first, build_last),
+                      lo, hi, std::span<const size_t>(probe_first, probe_last),
+                      build_offsets[b], ranges);
+                }
+              });
+
+          size_t total{};
+          for (const auto& [first, last] : ranges) {
+            total += last - first;
+          }
+          left_rows.reserve(total);
+          right_rows.reserve(total);
+          for (size_t i{}; i < left.rows; ++i) {
+            for (size_t k{ranges[i].first}; k < ranges[i].second; ++k) {
+              left_rows.push_back(i);
+              right_rows.push_back(build[k]);
+            }
+          }
+        }
+      },
+      right.columns.at(right_on));
+
+  return gather_join(left, right, left_rows, right_rows, by);
 }
 
 void DataFrame::print(size_t start, size_t end) const {
@@ -1443,25 +2472,29 @@ void DataFrame::print(size_t start, size_t end) const {
 
   std::cout << "\n";
 
+  // numbers follow the stream's current float format and precision
+  dispatch::CellFormat format{};
+  format.precision = static_cast<int>(std::cout.precision());
+  format.null_text = "NULL";
+  const auto floatfield{std::cout.flags() & std::ios::floatfield};
+  if (floatfield == std::ios::fixed) {
+    format.floats = std::chars_format::fixed;
+  } else if (floatfield == std::ios::scientific) {
+    format.floats = std::chars_format::scientific;
+  }
+
+  std::vector<dispatch::Cells> cells(column_info.size());
+  for (size_t j{}; j < column_info.size(); ++j) {
+    dispatch::run<dispatch::FormatCells>(columns.at(column_info[j]), start,
+                                         end, format, cells[j]);
+  }
+
   for (size_t i{start}; i < end; ++i) {
     int w{0};  // align widths
     std::cout << std::setw(widths[w++]) << i;
-    for (const auto& column_name : column_info) {
-      const auto& column{columns.at(column_name)};
-      std::visit(
-          [&](const auto& col) {
-            const auto& value{col[i]};
-
-            // use widths set from column name
-            std::cout << std::setw(widths[w++]);
-
-            if (!utils::is_null(value)) {
-              std::cout << value;
-            } else {
-              std::cout << "NULL";
-            }
-          },
-          column);
+    for (size_t j{}; j < column_info.size(); ++j) {
+      // use widths set from column name
+      std::cout << std::setw(widths[w++]) << cells[j][i - start];
     }
     std::cout << "\n";
   }
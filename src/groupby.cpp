@@ -0,0 +1,367 @@
+#include "groupby.h"
+
+#include <cmath>
+
+#include "hash_table.h"
+#include "parallel.h"
+#include "reduce.h"
+
+namespace df {
+namespace {
+/*
+compensated sums per group, accumulated in row order, and when deviations
+is given the compensated squared deviations from each group mean. agg and
+transform both reduce through here, so they agree to the last bit
+*/
+template <typename T>
+void group_moments(const std::vector<T>& values,
+                   const std::vector<size_t>& group_ids,
+                   std::vector<reduce::Accumulator>& sums,
+                   std::vector<reduce::Accumulator>* deviations) {
+  for (size_t i{}; i < values.size(); ++i) {
+    if (!utils::is_null(values[i])) {
+      sums[group_ids[i]].add(static_cast<double>(values[i]));
+      ++sums[group_ids[i]].count;
+    }
+  }
+
+  if (deviations == nullptr) {
+    return;
+  }
+  for (size_t i{}; i < values.size(); ++i) {
+    if (!utils::is_null(values[i])) {
+      const auto& group{sums[group_ids[i]]};
+      double d{static_cast<double>(values[i]) - group.result() / group.count};
+      (*deviations)[group_ids[i]].add(d * d);
+    }
+  }
+}
+}  // namespace
+
+// =====================================
+// constructors
+// =====================================
+
+GroupBy::GroupBy(const DataFrame& d, std::vector<std::string> by)
+    : df(d), keys(std::move(by)) {
+  if (keys.empty()) {
+    throw std::invalid_argument("no columns indicated for grouping");
+  }
+  df.validate_subset(keys);
+
+  std::vector<uint64_t> row_hashes{DataFrame::compute_row_hashes(df, keys)};
+
+  FlatHashMap<uint64_t, size_t, IdentityHash> ids{};
+  group_ids.resize(row_hashes.size());
+
+  for (size_t i{}; i < row_hashes.size(); ++i) {
+    size_t& id{ids[row_hashes[i]]};
+    if (id == 0) {  // ids are stored offset by one, zero marks a new group
+      first_rows.push_back(i);
+      id = first_rows.size();
+    }
+    group_ids[i] = id - 1;
+  }
+}
+
+size_t GroupBy::ngroups() const { return first_rows.size(); }
+
+const std::vector<size_t>& GroupBy::get_group_ids() const { return group_ids; }
+
+const std::vector<size_t>& GroupBy::get_first_rows() const {
+  return first_rows;
+}
+
+// =====================================
+// aggregation methods
+// =====================================
+
+DataFrame GroupBy::agg(const std::string& column_name,
+                       Aggregation aggregation) const {
+  const ColumnVariant& target{value_column(column_name)};
+  DataFrame result{key_frame()};
+  const size_t n{ngroups()};
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+
+        switch (aggregation) {
+          case Aggregation::Count: {
+            std::vector<int64_t> counts(n, 0);
+            for (size_t i{}; i < column.nrows(); ++i) {
+              counts[group_ids[i]] += !utils::is_null(column.data[i]);
+            }
+            result.add_column<int64_t>(column_name, std::move(counts));
+            break;
+          }
+          case Aggregation::Sum:
+          case Aggregation::Mean:
+          case Aggregation::Variance: {
+            if constexpr (std::is_arithmetic_v<T>) {
+              std::vector<reduce::Accumulator> sums(n);
+              std::vector<reduce::Accumulator> deviations(n);
+              group_moments(
+                  column.data, group_ids, sums,
+                  aggregation == Aggregation::Variance ? &deviations : nullptr);
+
+              std::vector<double> output(n, utils::get_null<double>());
+              for (size_t g{}; g < n; ++g) {
+                const size_t count{sums[g].count};
+                if (aggregation == Aggregation::Sum && count > 0) {
+                  output[g] = sums[g].result();
+                } else if (aggregation == Aggregation::Mean && count > 0) {
+                  output[g] = sums[g].result() / count;
+                } else if (aggregation == Aggregation::Variance && count > 1) {
+                  output[g] = deviations[g].result() / (count - 1);
+                }
+              }
+              result.add_column<double>(column_name, std::move(output));
+            } else {
+              throw std::invalid_argument("column is not numeric type");
+            }
+            break;
+          }
+          case Aggregation::Min:
+          case Aggregation::Max: {
+            std::vector<T> output(n, utils::get_null<T>());
+            for (size_t i{}; i < column.nrows(); ++i) {
+              const T& value{column.data[i]};
+              if (utils::is_null(value)) {
+                continue;
+              }
+
+              T& current{output[group_ids[i]]};
+              if (utils::is_null(current) ||
+                  (aggregation == Aggregation::Min ? value < current
+                                                   : value > current)) {
+                current = value;
+              }
+            }
+            result.add_column<T>(column_name, std::move(output));
+            break;
+          }
+          case Aggregation::ApproxNunique: {
+            std::vector<HyperLogLog> sketches{distinct_sketches(column_name)};
+            std::vector<int64_t> output(n);
+            for (size_t g{}; g < n; ++g) {
+              output[g] = std::llround(sketches[g].estimate());
+            }
+            result.add_column<int64_t>(column_name, std::move(output));
+            break;
+          }
+        }
+      },
+      target);
+
+  return result;
+}
+
+DataFrame GroupBy::approx_quantile(const std::string& column_name, double q,
+                                   double compression) const {
+  std::vector<TDigest> sketches{quantile_sketches(column_name, compression)};
+
+  std::vector<double> output(ngroups(), utils::get_null<double>());
+  for (size_t g{}; g < sketches.size(); ++g) {
+    if (!sketches[g].empty()) {
+      output[g] = sketches[g].quantile(q);
+    }
+  }
+
+  DataFrame result{key_frame()};
+  result.add_column<double>(column_name, std::move(output));
+  return result;
+}
+
+std::vector<HyperLogLog> GroupBy::distinct_sketches(
+    const std::string& column_name, uint8_t precision) const {
+  const ColumnVariant& target{value_column(column_name)};
+  std::vector<HyperLogLog> sketches(ngroups(), HyperLogLog{precision});
+
+  std::visit(
+      [&](const auto& column) {
+        std::vector<uint64_t> hashes{};
+        column.hash_into(hashes);
+        for (size_t i{}; i < column.nrows(); ++i) {
+          if (!utils::is_null(column.data[i])) {
+            sketches[group_ids[i]].add_hash(hashes[i]);
+          }
+        }
+      },
+      target);
+
+  return sketches;
+}
+
+std::vector<TDigest> GroupBy::quantile_sketches(const std::string& column_name,
+                                                double compression) const {
+  const ColumnVariant& target{value_column(column_name)};
+  std::vector<TDigest> sketches(ngroups(), TDigest{compression});
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+        if constexpr (std::is_arithmetic_v<T>) {
+          for (size_t i{}; i < column.nrows(); ++i) {
+            if (!utils::is_null(column.data[i])) {
+              sketches[group_ids[i]].add(static_cast<double>(column.data[i]));
+            }
+          }
+        } else {
+          throw std::invalid_argument("column is not numeric type");
+        }
+      },
+      target);
+
+  for (auto& digest : sketches) {
+    digest.compress();
+  }
+  return sketches;
+}
+
+// =====================================
+// transform methods
+// =====================================
+
+/*
+NOTE: group statistics come from the same compensated sums and squared
+deviations as agg, then a last pass scatters them back through the group id
+vector. rank sorts the rows of each group instead and averages ties
+*/
+std::vector<double> GroupBy::transform(const std::string& column_name,
+                                       Transform op) const {
+  const ColumnVariant& target{value_column(column_name)};
+  const size_t n{group_ids.size()};
+  std::vector<double> result(n, utils::get_null<double>());
+
+  std::visit(
+      [&](const auto& column) {
+        using T = std::decay_t<decltype(column)>::value_type;
+        if constexpr (!std::is_arithmetic_v<T>) {
+          throw std::invalid_argument("column is not numeric type");
+        } else {
+          const std::vector<T>& values{column.data};
+
+          if (op == Transform::Rank) {
+            std::vector<std::vector<size_t>> members(ngroups());
+            for (size_t i{}; i < n; ++i) {
+              if (!utils::is_null(values[i])) {
+                members[group_ids[i]].push_back(i);
+              }
+            }
+
+            parallel::for_chunks(
+                members.size(), 1, [&](size_t, size_t begin, size_t end) {
+                  for (size_t g{begin}; g < end; ++g) {
+                    std::vector<size_t>& order{members[g]};
+                    std::ranges::sort(order, [&](size_t a, size_t b) {
+                      return values[a] < values[b];
+                    });
+
+                    for (size_t k{}; k < order.size();) {
+                      size_t j{k + 1};
+                      while (j < order.size() &&
+                             values[order[j]] == values[order[k]]) {
+                        ++j;
+                      }
+                      double average{(k + 1 + j) / 2.0};
+                      for (size_t t{k}; t < j; ++t) {
+                        result[order[t]] = average;
+                      }
+                      k = j;
+                    }
+                  }
+                });
+            return;
+          }
+
+          std::vector<reduce::Accumulator> sums(ngroups());
+          std::vector<reduce::Accumulator> deviations(ngroups());
+          group_moments(values, group_ids, sums,
+                        op == Transform::ZScore ? &deviations : nullptr);
+
+          std::vector<double> stats(ngroups(), utils::get_null<double>());
+          std::vector<double> scales(ngroups(), utils::get_null<double>());
+          for (size_t g{}; g < ngroups(); ++g) {
+            const size_t count{sums[g].count};
+            switch (op) {
+              case Transform::Count:
+                stats[g] = static_cast<double>(count);
+                break;
+              case Transform::Sum:
+                if (count > 0) {
+                  stats[g] = sums[g].result();
+                }
+                break;
+              case Transform::Mean:
+              case Transform::Demean:
+                if (count > 0) {
+                  stats[g] = sums[g].result() / count;
+                }
+                break;
+              case Transform::ZScore:
+                if (count > 1 && deviations[g].result() > 0.0) {
+                  stats[g] = sums[g].result() / count;
+                  scales[g] = std::sqrt(deviations[g].result() / (count - 1));
+                }
+                break;
+              case Transform::Rank:
+                break;
+            }
+          }
+
+          parallel::for_chunks(
+              n, 1 << 16, [&](size_t, size_t begin, size_t end) {
+                for (size_t i{begin}; i < end; ++i) {
+                  size_t g{group_ids[i]};
+                  double stat{stats[g]};
+                  if (op == Transform::Count || op == Transform::Sum ||
+                      op == Transform::Mean) {
+                    result[i] = stat;  // broadcast, defined for null rows too
+                  } else if (!utils::is_null(values[i]) &&
+                             !utils::is_null(stat)) {
+                    double x{static_cast<double>(values[i])};
+                    result[i] = op == Transform::Demean
+                                    ? x - stat
+                                    : (x - stat) / scales[g];
+                  }
+                }
+              });
+        }
+      },
+      target);
+
+  return result;
+}
+
+// =====================================
+// private helper methods
+// =====================================
+
+DataFrame GroupBy::key_frame() const {
+  DataFrame result{};
+  for (const auto& key : keys) {
+    std::visit(
+        [&](const auto& column) {
+          using T = std::decay_t<decltype(column)>::value_type;
+          std::vector<T> values{};
+          values.reserve(first_rows.size());
+          for (const auto& row : first_rows) {
+            values.push_back(column.data[row]);
+          }
+          result.add_column<T>(key, std::move(values));
+        },
+        value_column(key));
+  }
+  return result;
+}
+
+const ColumnVariant& GroupBy::value_column(
+    const std::string& column_name) const {
+  const ColumnVariant* col{df.get_column(column_name)};
+  if (col == nullptr) {
+    throw std::invalid_argument("column not found: " + column_name);
+  }
+  return *col;
+}
+}  // namespace df
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "bitmap.h"
+#include "dataframe.h"
+
+using namespace df;
+
+TEST(BitmapTest, SetOperationsAcrossContainerKinds) {
+  // a dense chunk, a sparse chunk and rows added out of order
+  std::vector<size_t> evens{};
+  std::vector<size_t> thirds{};
+  for (size_t i{}; i < 70000; i += 2) {
+    evens.push_back(i);
+  }
+  for (size_t i{}; i < 70000; i += 3) {
+    thirds.push_back(i);
+  }
+
+  RoaringBitmap a{RoaringBitmap::from_selection(evens)};
+  RoaringBitmap b{};
+  for (auto it{thirds.rbegin()}; it != thirds.rend(); ++it) {
+    b.add(*it);
+  }
+  b.add(1000000);
+
+  EXPECT_EQ(a.size(), evens.size());
+  EXPECT_EQ(b.size(), thirds.size() + 1);
+  EXPECT_TRUE(b.contains(1000000));
+  EXPECT_FALSE(b.contains(1));
+
+  std::vector<size_t> both{};
+  std::vector<size_t> either{};
+  std::ranges::set_intersection(evens, thirds, std::back_inserter(both));
+  std::ranges::set_union(evens, thirds, std::back_inserter(either));
+  either.push_back(1000000);
+
+  EXPECT_EQ((a & b).to_selection(), both);
+  EXPECT_EQ((a | b).to_selection(), either);
+  EXPECT_TRUE((a & RoaringBitmap{}).empty());
+
+  // sparse result of a dense and dense intersection
+  RoaringBitmap c{RoaringBitmap::from_selection({0, 6, 12})};
+  EXPECT_EQ((a & b & c).to_selection(), (std::vector<size_t>{0, 6, 12}));
+}
+
+TEST(BitmapTest, IndexFollowsAppendsAndMutations) {
+  Column<std::string> venue{std::vector<std::string>{"A", "B", "", "C", "A"}};
+  EXPECT_FALSE(venue.has_index());
+  venue.build_index();
+  EXPECT_TRUE(venue.has_index());
+
+  venue.append("B");
+  EXPECT_EQ(venue.rows_in({"A", "B"}).to_selection(),
+            (std::vector<size_t>{0, 1, 4, 5}));
+  EXPECT_EQ(venue.isin({"C", ""}), (std::vector<size_t>{3}));
+
+  venue[0] = "C";
+  EXPECT_EQ(venue.isin({"C"}), (std::vector<size_t>{0, 3}));
+  venue.erase(1);
+  EXPECT_EQ(venue.isin({"B"}), (std::vector<size_t>{4}));
+
+  venue.drop_index();
+  EXPECT_EQ(venue.rows_in({"A"}).to_selection(), (std::vector<size_t>{3}));
+}
+
+TEST(BitmapTest, FramePredicatesCombineThroughBitmaps) {
+  DataFrame trades{};
+  trades.add_column<std::string>(
+      "venue", {"A", "B", "C", "A", "B", "C", "A", "B"});
+  trades.add_column<std::string>(
+      "side", {"BUY", "SELL", "BUY", "SELL", "BUY", "BUY", "BUY", "SELL"});
+  trades.add_column<int64_t>("qty", {1, 2, 3, 4, 5, 6, 7, 8});
+
+  trades.build_index("venue").build_index("side");
+  trades.add_row(std::unordered_map<std::string, RowVariant>{
+      {"venue", std::string{"B"}},
+      {"side", std::string{"BUY"}},
+      {"qty", int64_t{9}}});
+
+  RoaringBitmap rows{
+      trades.rows_in<std::string>("venue", {"A", "B"}) &
+      trades.rows_in<std::string>("side", {"BUY"})};
+  DataFrame selected{trades.take(rows.to_selection())};
+
+  const Column<int64_t>* qty{selected.get_column<int64_t>("qty")};
+  ASSERT_NE(qty, nullptr);
+  EXPECT_EQ(std::vector<int64_t>(qty->begin(), qty->end()),
+            (std::vector<int64_t>{1, 5, 7, 9}));
+
+  // unindexed columns give the same bitmap from a scan
+  EXPECT_EQ(trades.rows_in<int64_t>("qty", {1, 5, 7, 9}), rows);
+  EXPECT_THROW(trades.rows_in<double>("qty", {1.0}), std::invalid_argument);
+  EXPECT_THROW(trades.build_index("missing"), std::invalid_argument);
+}
+
+TEST(BitmapTest, GathersKeepTheIndex) {
+  DataFrame trades{};
+  trades.add_column<std::string>("venue", {"B", "A", "C", "A", "B"});
+  trades.add_column<int64_t>("qty", {5, 1, 3, 4, 2});
+  trades.build_index("venue");
+
+  DataFrame venues{};
+  venues.add_column<std::string>("venue", {"A", "B"});
+  venues.add_column<std::string>("city", {"NY", "LDN"});
+
+  trades.sort_by("qty");
+  std::vector<DataFrame> outputs{};
+  outputs.push_back(trades);
+  outputs.push_back(trades.take({4, 3, 0}));
+  outputs.push_back(trades.slice(1, 4));
+  outputs.push_back(DataFrame::inner_join(trades, venues, {"venue"}));
+  outputs.push_back(DataFrame::left_join(trades, venues, {"venue"}));
+
+  for (const auto& frame : outputs) {
+    const Column<std::string>* venue{frame.get_column<std::string>("venue")};
+    ASSERT_NE(venue, nullptr);
+    EXPECT_TRUE(venue->has_index());
+    // the index built on first use matches a scan of the gathered rows
+    std::vector<size_t> expected{};
+    for (size_t i{}; i < venue->nrows(); ++i) {
+      if ((*venue)[i] == "A") {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(venue->rows_in({"A"}).to_selection(), expected);
+  }
+
+  EXPECT_FALSE(outputs[1].get_column<int64_t>("qty")->has_index());
+  trades.drop_index("venue");
+  EXPECT_FALSE(trades.take({0}).get_column<std::string>("venue")->has_index());
+}
+
+TEST(BitmapTest, ConcurrentReadersBuildOneIndex) {
+  Column<int64_t> codes{};
+  for (int64_t i{}; i < 100000; ++i) {
+    codes.append(i % 50);
+  }
+  codes.build_index();
+  codes[7] = 99;  // drops the index, the readers below race its rebuild
+
+  const Column<int64_t>& view{codes};
+  std::vector<std::thread> readers{};
+  std::vector<int> ok(8, 0);
+  for (size_t t{}; t < ok.size(); ++t) {
+    readers.emplace_back([&view, &ok, t]() {
+      ok[t] = view.rows_in({99}).to_selection() == std::vector<size_t>{7} &&
+              view.isin({7}).size() == 1999;
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(ok, std::vector<int>(ok.size(), 1));
+}
@@ -1,7 +1,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <random>
+#include <thread>
 
 #include "column.h"
 
@@ -137,6 +139,52 @@ TYPED_TEST(ColumnTypedTest, DeserialzationFailsOnInvalidBytes) {
                std::runtime_error);
 }
 
+TYPED_TEST(ColumnTypedTest, HashesRowsColumnAtATime) {
+  typename TestFixture::Col col{};
+  for (int i{}; i < 100; ++i) {
+    col.append(this->get_test_value(i % 10));
+  }
+
+  std::vector<uint64_t> hashes{};
+  col.hash_into(hashes);
+  ASSERT_EQ(hashes.size(), col.nrows());
+
+  // equal values hash equal, distinct values spread out
+  EXPECT_EQ(hashes[0], hashes[10]);
+  EXPECT_NE(hashes[0], hashes[1]);
+  EXPECT_EQ(hashes[3], hash::hash_value(col[3]));
+
+  std::vector<uint64_t> combined(col.nrows(), hash::seed);
+  col.combine_hash_into(combined);
+  EXPECT_EQ(combined[0], combined[10]);
+  EXPECT_NE(combined[0], combined[1]);
+
+  std::vector<uint64_t> wrong_length(3);
+  EXPECT_THROW(col.combine_hash_into(wrong_length), std::invalid_argument);
+}
+
+TYPED_TEST(ColumnTypedTest, IsinSelectsMatchingRows) {
+  typename TestFixture::Col col{};
+  for (int i{}; i < 10; ++i) {
+    col.append(this->get_test_value(i));
+  }
+  col.append(this->get_null_test_value());
+
+  auto selection{
+      col.isin({this->get_test_value(2), this->get_test_value(7),
+                this->get_test_value(42), this->get_null_test_value()})};
+  EXPECT_THAT(selection, testing::ElementsAre(2, 7));
+
+  EXPECT_TRUE(col.isin({}).empty());
+
+  // large sets go through the bloom prefilter, which has no false negatives
+  std::vector<TypeParam> many{};
+  for (int i{}; i < 10000; i += 2) {
+    many.push_back(this->get_test_value(i));
+  }
+  EXPECT_THAT(col.isin(many), testing::ElementsAre(0, 2, 4, 6, 8));
+}
+
 TYPED_TEST(ColumnTypedTest, MaximumCalculatesCorrectly) {
   typename TestFixture::Col col{};
   EXPECT_THROW(col.maximum(), std::invalid_argument);
@@ -210,6 +258,44 @@ TYPED_TEST(ColumnTypedTest, ModeCalculatesCorrectly) {
               testing::UnorderedElementsAre(first_mode, second_mode));
 }
 
+TYPED_TEST(ColumnTypedTest, ValueCountsUniqueAndNunique) {
+  typename TestFixture::Col col{};
+  EXPECT_TRUE(col.value_counts().empty());
+  EXPECT_EQ(col.nunique(), 0);
+
+  // 0 x3, 1 x2, 2 x1 plus a null
+  for (int i : {1, 0, 2, 0, 1, 0}) {
+    col.append(this->get_test_value(i));
+  }
+  col.append(this->get_null_test_value());
+
+  auto counts{col.value_counts()};
+  ASSERT_EQ(counts.size(), 3);
+  EXPECT_EQ(counts[0], std::make_pair(this->get_test_value(0), size_t{3}));
+  EXPECT_EQ(counts[1], std::make_pair(this->get_test_value(1), size_t{2}));
+  EXPECT_EQ(counts[2], std::make_pair(this->get_test_value(2), size_t{1}));
+
+  EXPECT_THAT(col.unique(),
+              testing::ElementsAre(this->get_test_value(0),
+                                   this->get_test_value(1),
+                                   this->get_test_value(2)));
+  EXPECT_EQ(col.nunique(), 3);
+}
+
+TYPED_TEST(ColumnTypedTest, NuniqueHighCardinality) {
+  // mostly distinct values take the sort based path
+  typename TestFixture::Col col{};
+  const int n{100000};
+  for (int i{}; i < n; ++i) {
+    col.append(this->get_test_value(i % (n / 2)));
+  }
+
+  EXPECT_EQ(col.nunique(), n / 2);
+  auto counts{col.value_counts()};
+  EXPECT_EQ(counts.front().second, 2);
+  EXPECT_EQ(counts.back().second, 2);
+}
+
 TYPED_TEST(ColumnTypedTest, PercentileCalculatesCorrectly) {
   typename TestFixture::Col col{};
   if constexpr (std::is_same_v<TypeParam, std::string>) {
@@ -265,6 +351,125 @@ TYPED_TEST(ColumnTypedTest, SumCalculatesCorrectly) {
   }
 }
 
+TEST(ColumnReductionTest, SumIsCompensated) {
+  // a naive running sum loses every small term against the large one
+  Column<double> col{};
+  col.append(1e16);
+  for (int i{}; i < 1000; ++i) {
+    col.append(1.0);
+  }
+  col.append(-1e16);
+
+  EXPECT_EQ(col.sum(), 1000.0);
+}
+
+TEST(ColumnReductionTest, SumMatchesFixedBlockOrder) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+  std::vector<double> values(1000003);
+  for (auto& value : values) {
+    value = dist(gen) * 1e-3;
+  }
+  Column<double> col{values};
+
+  // the same blocks reduced sequentially give the bit identical result
+  std::vector<reduce::Accumulator> partials{};
+  for (size_t offset{}; offset < values.size(); offset += reduce::block_size) {
+    size_t length{std::min(reduce::block_size, values.size() - offset)};
+    partials.push_back(reduce::reduce_block(values.data() + offset, length,
+                                            [](double x) { return x; }));
+  }
+
+  EXPECT_EQ(col.sum(), reduce::combine_pairwise(partials).result());
+  EXPECT_EQ(col.sum(), col.sum());
+}
+
+TEST(ColumnZoneMapTest, ZonesFollowAppendsAndMutations) {
+  Column<int64_t> ticks{};
+  for (int64_t i{}; i < 200000; ++i) {
+    ticks.append(i % 7 == 3 ? utils::get_null<int64_t>() : 1000 + i);
+  }
+  EXPECT_EQ(ticks.minimum(), 1000);
+  EXPECT_EQ(ticks.maximum(), 1000 + 199999);
+
+  std::vector<size_t> selection{ticks.between(int64_t{70000},
+                                              int64_t{140000})};
+  std::vector<size_t> expected{};
+  for (size_t i{69000}; i <= 139000; ++i) {
+    if (i % 7 != 3) {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(selection, expected);
+
+  ticks[150000] = -5;  // marks its block dirty
+  EXPECT_EQ(ticks.minimum(), -5);
+  ticks.append(5000000);
+  EXPECT_EQ(ticks.maximum(), 5000000);
+
+  ticks.erase(150000);
+  ticks.resize(100000);
+  EXPECT_EQ(ticks.minimum(), 1000);
+  EXPECT_EQ(ticks.maximum(), 1000 + 99999);
+  EXPECT_TRUE(ticks.between(int64_t{200000}, int64_t{300000}).empty());
+}
+
+TEST(ColumnZoneMapTest, ExtendKeepsZonesCurrent) {
+  Column<int64_t> left{std::vector<int64_t>(100000, 50)};
+  EXPECT_EQ(left.minimum(), 50);  // zones built before the extend
+
+  Column<int64_t> right{};
+  right.append(utils::get_null<int64_t>());
+  right.append(-7);
+  right.append(900);
+  left.extend(std::move(right));
+
+  EXPECT_TRUE(right.empty());
+  EXPECT_EQ(left.nrows(), 100003);
+  EXPECT_EQ(left.get_null_count(), 1);
+  EXPECT_EQ(left.minimum(), -7);
+  EXPECT_EQ(left.maximum(), 900);
+  EXPECT_EQ(left.between(int64_t{-10}, int64_t{0}),
+            (std::vector<size_t>{100001}));
+}
+
+TEST(ColumnZoneMapTest, ConcurrentReadersAfterMutation) {
+  Column<int64_t> ticks{};
+  for (int64_t i{}; i < 300000; ++i) {
+    ticks.append(i % 1000);
+  }
+  ticks[250000] = -1;  // every reader below races the first rebuild
+  ticks[10] = 5000;
+
+  const Column<int64_t>& view{ticks};
+  std::vector<std::thread> readers{};
+  std::vector<int> ok(8, 0);
+  for (size_t t{}; t < ok.size(); ++t) {
+    readers.emplace_back([&view, &ok, t]() {
+      ok[t] = view.minimum() == -1 && view.maximum() == 5000 &&
+              view.nunique() == 1002 &&
+              view.between(int64_t{4000}, int64_t{6000}).size() == 1;
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(ok, std::vector<int>(ok.size(), 1));
+}
+
+TYPED_TEST(ColumnTypedTest, BetweenSelectsInclusiveRange) {
+  typename TestFixture::Col col{};
+  for (int i{}; i < 6; ++i) {
+    col.append(i == 2 ? this->get_null_test_value() : this->get_test_value(i));
+  }
+
+  EXPECT_EQ(col.between(this->get_test_value(1), this->get_test_value(4)),
+            (std::vector<size_t>{1, 3, 4}));
+  EXPECT_TRUE(
+      col.between(this->get_test_value(4), this->get_test_value(1)).empty());
+}
+
 TYPED_TEST(ColumnTypedTest, MedianCalculatesCorrectly) {
   typename TestFixture::Col col{};
   if constexpr (std::is_same_v<TypeParam, std::string>) {
@@ -365,6 +570,60 @@ TYPED_TEST(ColumnTypedTest, VarianceCalculatesCorrectly) {
   }
 }
 
+TYPED_TEST(ColumnTypedTest, HistogramAndCutAgree) {
+  typename TestFixture::Col col{};
+  if constexpr (std::is_same_v<TypeParam, std::string>) {
+    col.append(this->get_test_value());
+    EXPECT_THROW(col.histogram(4), std::invalid_argument);
+    EXPECT_THROW(col.cut(4), std::invalid_argument);
+  } else {
+    for (int i{}; i < 10; ++i) {
+      col.append(static_cast<TypeParam>(i));
+    }
+    col.append(this->get_null_test_value());
+
+    std::vector<double> edges{0.0, 2.5, 5.0, 9.0};
+    EXPECT_THAT(col.histogram(edges), testing::ElementsAre(3, 2, 5));
+
+    auto codes{col.cut(edges)};
+    ASSERT_EQ(codes.nrows(), col.nrows());
+    EXPECT_EQ(codes[0], 0);
+    EXPECT_EQ(codes[3], 1);
+    EXPECT_EQ(codes[9], 2);  // right edge closes the last bin
+    EXPECT_TRUE(utils::is_null(codes[10]));
+    EXPECT_EQ(codes.get_null_count(), 1);
+
+    // values outside the edges get no bin
+    EXPECT_TRUE(utils::is_null(col.cut({1.0, 2.0})[0]));
+
+    EXPECT_THAT(col.histogram(3), testing::ElementsAre(3, 3, 4));
+    EXPECT_THROW(col.histogram({1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(col.histogram(0), std::invalid_argument);
+  }
+}
+
+TYPED_TEST(ColumnTypedTest, QcutBalancesBins) {
+  typename TestFixture::Col col{};
+  if constexpr (!std::is_same_v<TypeParam, std::string>) {
+    const int64_t n{400000};  // large enough to split across threads
+    for (int64_t i{}; i < n; ++i) {
+      col.append(static_cast<TypeParam>(i * 7919 % n));
+    }
+
+    auto codes{col.qcut(4)};
+    std::vector<size_t> counts(4, 0);
+    for (const auto& code : codes) {
+      ASSERT_GE(code, 0);
+      ASSERT_LT(code, 4);
+      ++counts[code];
+    }
+    EXPECT_THAT(counts, testing::Each(testing::Eq(n / 4)));
+
+    auto hist{col.histogram(4)};
+    EXPECT_EQ(std::accumulate(hist.begin(), hist.end(), size_t{0}), n);
+  }
+}
+
 TYPED_TEST(ColumnTypedTest, EqualityOperatorOverloadedCorrectly) {
   typename TestFixture::Col col1{};
   typename TestFixture::Col col2{};
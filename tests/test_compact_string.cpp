@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "compact_string.h"
+
+using namespace df;
+
+class CompactStringTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> values{"AAPL",
+                                  "",
+                                  "MSFT",
+                                  "ORD-2024-000123",
+                                  "AAPL",
+                                  "ORD-2024-000124",
+                                  "AAP",
+                                  std::string("AA\0L", 4),
+                                  "twelve bytes",
+                                  "ORD-2024-000123"};
+  CompactStringColumn column{values};
+};
+
+TEST_F(CompactStringTest, RoundTripsInlineAndBufferedStrings) {
+  ASSERT_EQ(column.nrows(), values.size());
+  for (size_t i{}; i < values.size(); ++i) {
+    EXPECT_EQ(column[i], values[i]);
+  }
+  EXPECT_EQ(column.buffer_bytes(), 3 * 15);  // only the long ids spill
+
+  Column<std::string> restored{column.to_column()};
+  EXPECT_EQ(std::vector<std::string>(restored.begin(), restored.end()),
+            values);
+
+  std::vector<uint64_t> compact_hashes{};
+  std::vector<uint64_t> hashes{};
+  column.hash_into(compact_hashes);
+  restored.hash_into(hashes);
+  EXPECT_EQ(compact_hashes, hashes);
+}
+
+TEST_F(CompactStringTest, ComparesLikeStdString) {
+  for (size_t i{}; i < values.size(); ++i) {
+    for (size_t j{}; j < values.size(); ++j) {
+      EXPECT_EQ(column.equal(i, j), values[i] == values[j]);
+      EXPECT_EQ(column.less(i, j), values[i] < values[j]);
+    }
+  }
+
+  EXPECT_EQ(column.equals("AAPL"), (std::vector<size_t>{0, 4}));
+  EXPECT_EQ(column.equals("ORD-2024-000123"), (std::vector<size_t>{3, 9}));
+  EXPECT_EQ(column.distinct_rows(),
+            (std::vector<size_t>{0, 1, 2, 3, 5, 6, 7, 8}));
+  EXPECT_EQ(column.argsort(),
+            sort::argsort(values, true, SortMethod::Adaptive));
+  EXPECT_EQ(column.argsort(false),
+            sort::argsort(values, false, SortMethod::Adaptive));
+}
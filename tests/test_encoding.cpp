@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "encoding.h"
+
+using namespace df;
+
+class EncodingTest : public ::testing::TestWithParam<Encoding> {
+ protected:
+  Column<int64_t> ticks{};
+
+  void SetUp() override {
+    std::mt19937_64 gen{3};
+    std::uniform_int_distribution<int64_t> step(0, 900);
+    std::vector<int64_t> values{};
+
+    int64_t ts{1'700'000'000'000'000'000};
+    for (size_t i{}; i < 10000; ++i) {
+      ts += step(gen);
+      values.push_back(i % 997 == 5 ? utils::get_null<int64_t>() : ts);
+    }
+    values[4100] = std::numeric_limits<int64_t>::max();  // full width block
+    ticks = Column<int64_t>(values);
+  }
+};
+
+TEST_P(EncodingTest, RoundTripsAndScansEncodedForm) {
+  EncodedColumn encoded{EncodedColumn::encode(ticks, GetParam())};
+  ASSERT_EQ(encoded.nrows(), ticks.nrows());
+  EXPECT_EQ(encoded.decode(), ticks);
+  EXPECT_EQ(encoded.get_null_count(), ticks.get_null_count());
+
+  EXPECT_EQ(encoded.minimum(), ticks.minimum());
+  EXPECT_EQ(encoded.maximum(), ticks.maximum());
+  EXPECT_EQ(encoded.sum(), ticks.sum());  // same block order
+
+  int64_t lo{ticks[3000]};
+  int64_t hi{ticks[3200]};
+  std::vector<size_t> expected{};
+  for (size_t i{}; i < ticks.nrows(); ++i) {
+    if (!utils::is_null(ticks[i]) && ticks[i] >= lo && ticks[i] <= hi) {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(encoded.between(lo, hi), expected);
+  EXPECT_EQ(encoded.equals(ticks[4100]), (std::vector<size_t>{4100}));
+}
+
+TEST_P(EncodingTest, SumMatchesColumnSumOnLongRuns) {
+  // long runs of large and small values, where run * value products and
+  // row by row compensated sums round differently
+  std::vector<int64_t> values{};
+  for (size_t i{}; i < 50000; ++i) {
+    size_t run{i / 3000};
+    values.push_back(run % 3 == 0   ? utils::get_null<int64_t>()
+                     : run % 3 == 1 ? (int64_t{1} << 53) + 1 + 2 * run
+                                    : -7);
+  }
+  Column<int64_t> column{values};
+
+  EncodedColumn encoded{EncodedColumn::encode(column, GetParam())};
+  EXPECT_EQ(encoded.sum(), column.sum());
+}
+
+INSTANTIATE_TEST_SUITE_P(AllEncodings, EncodingTest,
+                         ::testing::Values(Encoding::BitPacked, Encoding::Delta,
+                                           Encoding::RunLength));
+
+TEST(EncodingSizeTest, PicksSmallestEncoding) {
+  std::vector<int64_t> sides(100000);
+  std::vector<int64_t> timestamps(100000);
+  for (size_t i{}; i < sides.size(); ++i) {
+    sides[i] = (i / 500) % 2;
+    timestamps[i] = 1'700'000'000'000 + static_cast<int64_t>(i) * 3;
+  }
+
+  EncodedColumn runs{EncodedColumn::encode(Column<int64_t>(sides))};
+  EXPECT_EQ(runs.get_encoding(), Encoding::RunLength);
+  EXPECT_DOUBLE_EQ(runs.sum(), 50000.0);
+
+  EncodedColumn deltas{EncodedColumn::encode(Column<int64_t>(timestamps))};
+  EXPECT_EQ(deltas.get_encoding(), Encoding::Delta);
+  EXPECT_LT(deltas.size_bytes() * 8, timestamps.size() * sizeof(int64_t));
+}
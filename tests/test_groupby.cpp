@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "dataframe.h"
+
+using namespace df;
+
+class GroupByTest : public ::testing::Test {
+ protected:
+  DataFrame df{};
+
+  void SetUp() override {
+    df.add_column<std::string>("key", {"a", "b", "a", "b", "a", "c"});
+    df.add_column<double>(
+        "value", {1.0, 10.0, 2.0, 20.0, utils::get_null<double>(), 5.0});
+  }
+};
+
+TEST_F(GroupByTest, TransformBroadcastsGroupStatistics) {
+  GroupBy groups{df.groupby({"key"})};
+
+  std::vector<double> sums{groups.transform("value", Transform::Sum)};
+  EXPECT_EQ(sums, (std::vector<double>{3.0, 30.0, 3.0, 30.0, 3.0, 5.0}));
+
+  std::vector<double> counts{groups.transform("value", Transform::Count)};
+  EXPECT_EQ(counts, (std::vector<double>{2.0, 2.0, 2.0, 2.0, 2.0, 1.0}));
+
+  std::vector<double> demeaned{groups.transform("value", Transform::Demean)};
+  EXPECT_DOUBLE_EQ(demeaned[0], -0.5);
+  EXPECT_DOUBLE_EQ(demeaned[3], 5.0);
+  EXPECT_TRUE(utils::is_null(demeaned[4]));
+  EXPECT_DOUBLE_EQ(demeaned[5], 0.0);
+}
+
+TEST_F(GroupByTest, TransformZScoreAndRank) {
+  GroupBy groups{df.groupby({"key"})};
+
+  std::vector<double> z{groups.transform("value", Transform::ZScore)};
+  EXPECT_NEAR(z[0], -1.0 / std::sqrt(2.0), 1e-12);
+  EXPECT_NEAR(z[3], 1.0 / std::sqrt(2.0), 1e-12);
+  EXPECT_TRUE(utils::is_null(z[4]));
+  EXPECT_TRUE(utils::is_null(z[5]));  // single member, no spread
+
+  df.update<double>(4, "value", 2.0);
+  std::vector<double> ranks{
+      df.groupby({"key"}).transform("value", Transform::Rank)};
+  EXPECT_EQ(ranks, (std::vector<double>{1.0, 1.0, 2.5, 2.0, 2.5, 1.0}));
+
+  EXPECT_THROW(groups.transform("key", Transform::Mean),
+               std::invalid_argument);
+}
+
+template <Storable T>
+std::vector<T> values_of(const DataFrame& df, const std::string& name) {
+  const Column<T>* col{df.get_column<T>(name)};
+  return std::vector<T>(col->begin(), col->end());
+}
+
+class AggregationTest : public ::testing::Test {
+ protected:
+  const double null{utils::get_null<double>()};
+  const int64_t int_null{utils::get_null<int64_t>()};
+  DataFrame df{};
+
+  void SetUp() override {
+    // group d holds only nulls
+    df.add_column<std::string>("key", {"a", "b", "a", "b", "a", "c", "d"});
+    df.add_column<double>("value", {1.0, 10.0, 2.0, 20.0, null, 5.0, null});
+    df.add_column<int64_t>("qty", {3, int_null, 3, 4, 7, 1, int_null});
+  }
+};
+
+TEST_F(AggregationTest, AggregatesSkipNulls) {
+  GroupBy groups{df.groupby({"key"})};
+  ASSERT_EQ(groups.ngroups(), 4);
+
+  DataFrame counts{groups.agg("value", Aggregation::Count)};
+  EXPECT_EQ(values_of<std::string>(counts, "key"),
+            (std::vector<std::string>{"a", "b", "c", "d"}));
+  EXPECT_EQ(values_of<int64_t>(counts, "value"),
+            (std::vector<int64_t>{2, 2, 1, 0}));
+
+  EXPECT_EQ(values_of<double>(groups.agg("value", Aggregation::Sum), "value"),
+            (std::vector<double>{3.0, 30.0, 5.0, null}));
+  EXPECT_EQ(values_of<double>(groups.agg("value", Aggregation::Mean), "value"),
+            (std::vector<double>{1.5, 15.0, 5.0, null}));
+  EXPECT_EQ(values_of<double>(groups.agg("value", Aggregation::Min), "value"),
+            (std::vector<double>{1.0, 10.0, 5.0, null}));
+  EXPECT_EQ(values_of<double>(groups.agg("value", Aggregation::Max), "value"),
+            (std::vector<double>{2.0, 20.0, 5.0, null}));
+
+  // min and max keep the column type
+  EXPECT_EQ(values_of<int64_t>(groups.agg("qty", Aggregation::Min), "qty"),
+            (std::vector<int64_t>{3, 4, 1, int_null}));
+  EXPECT_EQ(values_of<int64_t>(groups.agg("qty", Aggregation::Max), "qty"),
+            (std::vector<int64_t>{7, 4, 1, int_null}));
+  EXPECT_EQ(
+      values_of<int64_t>(groups.agg("qty", Aggregation::ApproxNunique), "qty"),
+      (std::vector<int64_t>{2, 1, 1, 0}));
+
+  EXPECT_THROW(groups.agg("key", Aggregation::Sum), std::invalid_argument);
+  EXPECT_THROW(groups.agg("missing", Aggregation::Count),
+               std::invalid_argument);
+}
+
+TEST_F(AggregationTest, ApproxQuantileAndSketches) {
+  GroupBy groups{df.groupby({"key"})};
+
+  std::vector<double> medians{
+      values_of<double>(groups.approx_quantile("value", 0.5), "value")};
+  EXPECT_DOUBLE_EQ(medians[0], 1.5);
+  EXPECT_DOUBLE_EQ(medians[1], 15.0);
+  EXPECT_DOUBLE_EQ(medians[2], 5.0);
+  EXPECT_TRUE(utils::is_null(medians[3]));
+
+  std::vector<TDigest> digests{groups.quantile_sketches("value")};
+  ASSERT_EQ(digests.size(), 4);
+  EXPECT_EQ(digests[0].count(), 2.0);
+  EXPECT_EQ(digests[2].count(), 1.0);
+  EXPECT_TRUE(digests[3].empty());
+
+  std::vector<HyperLogLog> distinct{groups.distinct_sketches("qty", 10)};
+  ASSERT_EQ(distinct.size(), 4);
+  EXPECT_EQ(distinct[0].get_precision(), 10);
+  EXPECT_EQ(std::llround(distinct[0].estimate()), 2);
+  EXPECT_EQ(distinct[3].estimate(), 0.0);
+
+  EXPECT_THROW(groups.quantile_sketches("key"), std::invalid_argument);
+}
+
+TEST(GroupByTransformTest, MatchesAggOnIllConditionedData) {
+  // large values that cancel, a running mean loses the small terms
+  std::vector<std::string> keys{};
+  std::vector<double> values{};
+  for (int i{}; i < 1000; ++i) {
+    keys.push_back(i % 2 == 0 ? "a" : "b");
+    values.push_back(i % 4 < 2 ? 1e16 : -1e16);
+    keys.push_back(keys.back());
+    values.push_back(i % 2 == 0 ? 1.0 : 0.25);
+  }
+
+  DataFrame df{};
+  df.add_column<std::string>("key", keys);
+  df.add_column<double>("value", values);
+  GroupBy groups{df.groupby({"key"})};
+
+  std::vector<double> means{
+      values_of<double>(groups.agg("value", Aggregation::Mean), "value")};
+  std::vector<double> sums{
+      values_of<double>(groups.agg("value", Aggregation::Sum), "value")};
+  EXPECT_EQ(means, (std::vector<double>{0.5, 0.125}));
+  EXPECT_EQ(sums, (std::vector<double>{500.0, 125.0}));
+
+  std::vector<double> broadcast{groups.transform("value", Transform::Mean)};
+  std::vector<double> totals{groups.transform("value", Transform::Sum)};
+  const std::vector<size_t>& ids{groups.get_group_ids()};
+  for (size_t i{}; i < keys.size(); ++i) {
+    EXPECT_EQ(broadcast[i], means[ids[i]]) << "row " << i;
+    EXPECT_EQ(totals[i], sums[ids[i]]) << "row " << i;
+  }
+
+  // the z-score scale is the standard deviation agg reports
+  std::vector<double> variances{
+      values_of<double>(groups.agg("value", Aggregation::Variance), "value")};
+  std::vector<double> z{groups.transform("value", Transform::ZScore)};
+  EXPECT_EQ(z[0], (values[0] - means[0]) / std::sqrt(variances[0]));
+}
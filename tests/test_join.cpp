@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <numeric>
+
+#include "dataframe.h"
+#include "merge.h"
+
+using namespace df;
+
+class RangeJoinTest : public ::testing::Test {
+ protected:
+  DataFrame news{};
+  DataFrame trades{};
+
+  void SetUp() override {
+    news.add_column<std::string>("symbol", {"x", "y", "x"});
+    news.add_column<int64_t>("ts", {100, 100, 300});
+
+    trades.add_column<std::string>("symbol", {"x", "x", "y", "x", "x", "y"});
+    trades.add_column<int64_t>("ts", {40, 60, 120, 150, 260, 500});
+    trades.add_column<double>(
+        "price", {1.0, 2.0, 3.0, 4.0, 5.0, utils::get_null<double>()});
+  }
+
+  template <Storable T>
+  std::vector<T> values_of(const DataFrame& df, const std::string& name) {
+    const Column<T>* col{df.get_column<T>(name)};
+    return std::vector<T>(col->begin(), col->end());
+  }
+};
+
+TEST_F(RangeJoinTest, BandJoinMatchesWithinWidth) {
+  DataFrame all{DataFrame::band_join(news, trades, "ts", "ts", 50, 50)};
+  EXPECT_EQ(all.column_names(),
+            (std::vector<std::string>{"symbol", "ts", "symbol_right",
+                                      "ts_right", "price"}));
+  EXPECT_EQ(values_of<int64_t>(all, "ts"),
+            (std::vector<int64_t>{100, 100, 100, 100, 100, 100, 300}));
+  EXPECT_EQ(values_of<int64_t>(all, "ts_right"),
+            (std::vector<int64_t>{60, 120, 150, 60, 120, 150, 260}));
+
+  DataFrame keyed{
+      DataFrame::band_join(news, trades, "ts", "ts", 50, 50, {"symbol"})};
+  EXPECT_EQ(keyed.column_names(),
+            (std::vector<std::string>{"symbol", "ts", "ts_right", "price"}));
+  EXPECT_EQ(values_of<int64_t>(keyed, "ts_right"),
+            (std::vector<int64_t>{60, 150, 120, 260}));
+}
+
+TEST_F(RangeJoinTest, IntervalJoinContainsPoints) {
+  DataFrame orders{};
+  orders.add_column<std::string>("symbol", {"x", "x", "y"});
+  orders.add_column<int64_t>("open", {0, 200, 0});
+  orders.add_column<int64_t>("close", {150, 100, 1000});
+
+  DataFrame joined{DataFrame::interval_join(orders, trades, "open", "close",
+                                            "ts", {"symbol"})};
+  EXPECT_EQ(values_of<int64_t>(joined, "ts"),
+            (std::vector<int64_t>{40, 60, 150, 120, 500}));
+  EXPECT_EQ(values_of<int64_t>(joined, "open"),
+            (std::vector<int64_t>{0, 0, 0, 0, 0}));
+
+  EXPECT_THROW(DataFrame::interval_join(orders, trades, "open", "close",
+                                        "price"),
+               std::invalid_argument);
+}
+
+TEST_F(RangeJoinTest, IntBandsRoundOutwardAndSaturate) {
+  const int64_t max{std::numeric_limits<int64_t>::max()};
+  DataFrame left{};
+  left.add_column<int64_t>("ts", {max - 1, utils::get_null<int64_t>(), 10,
+                                  std::numeric_limits<int64_t>::min() + 1});
+  DataFrame right{};
+  right.add_column<int64_t>("at", {max, 11, 12});
+
+  DataFrame near{DataFrame::band_join(left, right, "ts", "at", 0.5, 0.5)};
+  EXPECT_EQ(values_of<int64_t>(near, "ts"),
+            (std::vector<int64_t>{max - 1, 10}));
+  EXPECT_EQ(values_of<int64_t>(near, "at"), (std::vector<int64_t>{max, 11}));
+
+  DataFrame wide{DataFrame::band_join(left, right, "ts", "at", 1e30, 1e30)};
+  EXPECT_EQ(wide.nrows(), 9);  // every non-null left row meets every right
+
+  const double inf{std::numeric_limits<double>::infinity()};
+  EXPECT_THROW(DataFrame::band_join(left, right, "ts", "at", inf, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(DataFrame::band_join(left, right, "ts", "at", 0.0,
+                                    std::numeric_limits<double>::quiet_NaN()),
+               std::invalid_argument);
+  EXPECT_THROW(DataFrame::band_join(left, right, "ts", "at", -1.0, 0.0),
+               std::invalid_argument);
+}
+
+// hash joins on the same frames
+class HashJoinTest : public RangeJoinTest {};
+
+TEST_F(HashJoinTest, JoinsFillNullsAndSuffixClashingNames) {
+  DataFrame left{DataFrame::left_join(news, trades, {"symbol"})};
+  EXPECT_EQ(left.column_names(),
+            (std::vector<std::string>{"symbol", "ts", "ts_right", "price"}));
+  EXPECT_EQ(left.nrows(), 10);
+  EXPECT_EQ(values_of<int64_t>(left, "ts_right"),
+            (std::vector<int64_t>{40, 60, 150, 260, 120, 500, 40, 60, 150,
+                                  260}));
+  EXPECT_EQ(left.get_column<double>("price")->get_null_count(), 1);
+
+  DataFrame extra{};
+  extra.add_column<std::string>("symbol", {"y", "z"});
+  extra.add_column<int64_t>("size", {7, 8});
+
+  DataFrame full{DataFrame::full_join(news, extra, {"symbol"})};
+  EXPECT_EQ(values_of<std::string>(full, "symbol"),
+            (std::vector<std::string>{"x", "y", "x", ""}));
+  EXPECT_EQ(values_of<int64_t>(full, "size"),
+            (std::vector<int64_t>{utils::get_null<int64_t>(), 7,
+                                  utils::get_null<int64_t>(), 8}));
+  EXPECT_EQ(full.get_column<int64_t>("ts")->get_null_count(), 1);
+
+  DataFrame anti{DataFrame::anti_join(news, extra, {"symbol"})};
+  EXPECT_EQ(values_of<int64_t>(anti, "ts"), (std::vector<int64_t>{100, 300}));
+
+  trades.dropna();
+  EXPECT_EQ(trades.nrows(), 5);
+  EXPECT_EQ(trades.get_column<double>("price")->get_null_count(), 0);
+}
+
+TEST_F(HashJoinTest, SemiJoinKeepsEachMatchingRowOnce) {
+  DataFrame extra{};
+  extra.add_column<std::string>("symbol", {"y", "z"});
+  extra.add_column<int64_t>("size", {7, 8});
+
+  // matched and unmatched keys, only the left columns are kept
+  DataFrame some{DataFrame::semi_join(news, extra, {"symbol"})};
+  EXPECT_EQ(some.column_names(), (std::vector<std::string>{"symbol", "ts"}));
+  EXPECT_EQ(values_of<std::string>(some, "symbol"),
+            (std::vector<std::string>{"y"}));
+
+  // duplicate keys on the right never duplicate a left row
+  DataFrame once{DataFrame::semi_join(news, trades, {"symbol"})};
+  EXPECT_EQ(values_of<int64_t>(once, "ts"),
+            (std::vector<int64_t>{100, 100, 300}));
+  EXPECT_EQ(DataFrame::semi_join(trades, news, {"symbol"}).nrows(), 6);
+
+  DataFrame none{DataFrame::semi_join(news, extra.slice(1), {"symbol"})};
+  EXPECT_EQ(none.nrows(), 0);
+  EXPECT_EQ(none.column_names(), news.column_names());
+
+  EXPECT_THROW(DataFrame::semi_join(news, extra, {"size"}),
+               std::invalid_argument);
+}
+
+TEST_F(HashJoinTest, SemiJoinOnSeveralColumns) {
+  DataFrame keys{};
+  keys.add_column<std::string>("symbol", {"x", "y", "x", "x"});
+  keys.add_column<int64_t>("ts", {60, 60, 500, 60});
+
+  // both columns have to match, (y, 60) and (x, 500) match one column each
+  DataFrame both{DataFrame::semi_join(trades, keys, {"symbol", "ts"})};
+  EXPECT_EQ(values_of<double>(both, "price"), (std::vector<double>{2.0}));
+
+  // enough keys to go through the bloom prefilter
+  DataFrame many{};
+  std::vector<std::string> symbols{};
+  std::vector<int64_t> stamps{};
+  for (int64_t i{}; i < 10000; ++i) {
+    symbols.push_back(i % 2 == 0 ? "x" : "y");
+    stamps.push_back(i * 10 + 1);
+  }
+  symbols.push_back("y");
+  stamps.push_back(120);
+  many.add_column<std::string>("symbol", symbols);
+  many.add_column<int64_t>("ts", stamps);
+
+  DataFrame hit{DataFrame::semi_join(trades, many, {"symbol", "ts"})};
+  EXPECT_EQ(values_of<int64_t>(hit, "ts"), (std::vector<int64_t>{120}));
+}
+
+TEST_F(HashJoinTest, InnerJoinThroughBloomPrefilter) {
+  // more distinct keys than BloomFilter::min_keys, with a duplicated match
+  DataFrame many{};
+  std::vector<int64_t> stamps(10000);
+  std::iota(stamps.begin(), stamps.end(), int64_t{1000});
+  stamps.push_back(150);
+  stamps.push_back(150);
+  many.add_column<int64_t>("ts", stamps);
+  many.add_column<int64_t>("id", std::vector<int64_t>(stamps.size(), 7));
+
+  DataFrame joined{DataFrame::inner_join(trades, many, {"ts"})};
+  EXPECT_EQ(values_of<int64_t>(joined, "ts"),
+            (std::vector<int64_t>{150, 150}));
+  EXPECT_EQ(values_of<double>(joined, "price"),
+            (std::vector<double>{4.0, 4.0}));
+
+  // every probe row survives the filter when all of them match
+  DataFrame all{DataFrame::inner_join(many, many.slice(0, 5000), {"ts"})};
+  EXPECT_EQ(all.nrows(), 5000);
+}
+
+TEST(MergeSortedTest, MergesFeedsStably) {
+  std::vector<DataFrame> feeds(3);
+  feeds[0].add_column<int64_t>("ts", {1, 4, 4, 9});
+  feeds[0].add_column<std::string>("venue", {"a", "a", "a", "a"});
+  feeds[1].add_column<int64_t>("ts", {2, 4, 10});
+  feeds[1].add_column<std::string>("venue", {"b", "b", "b"});
+  feeds[2].add_column<int64_t>("ts", {0, 3});
+  feeds[2].add_column<std::string>("venue", {"c", "c"});
+
+  DataFrame tape{DataFrame::merge_sorted(feeds, "ts")};
+  ASSERT_EQ(tape.nrows(), 9);
+
+  const Column<int64_t>* ts{tape.get_column<int64_t>("ts")};
+  const Column<std::string>* venue{tape.get_column<std::string>("venue")};
+  EXPECT_EQ(std::vector<int64_t>(ts->begin(), ts->end()),
+            (std::vector<int64_t>{0, 1, 2, 3, 4, 4, 4, 9, 10}));
+  EXPECT_EQ(std::vector<std::string>(venue->begin(), venue->end()),
+            (std::vector<std::string>{"c", "a", "b", "c", "a", "a", "b", "a",
+                                      "b"}));
+
+  feeds[2].sort_by("ts", false);
+  EXPECT_THROW(DataFrame::merge_sorted(feeds, "ts"), std::invalid_argument);
+}
+
+TEST(MergeSortedTest, ParallelSplitsMatchSequentialMerge) {
+  std::vector<std::vector<int64_t>> keys(5);
+  std::vector<DataFrame> feeds(5);
+  for (size_t f{}; f < keys.size(); ++f) {
+    for (int64_t i{}; i < 60000; ++i) {
+      keys[f].push_back(i / static_cast<int64_t>(f + 1));  // duplicate keys
+    }
+    feeds[f].add_column<int64_t>("ts", keys[f]);
+    feeds[f].add_column<int64_t>("venue",
+                                 std::vector<int64_t>(keys[f].size(), f));
+  }
+
+  DataFrame tape{DataFrame::merge_sorted(feeds, "ts")};
+  const Column<int64_t>* ts{tape.get_column<int64_t>("ts")};
+  const Column<int64_t>* venue{tape.get_column<int64_t>("venue")};
+
+  std::vector<std::pair<int64_t, int64_t>> expected{};
+  for (size_t f{}; f < keys.size(); ++f) {
+    for (const auto& key : keys[f]) {
+      expected.emplace_back(key, f);
+    }
+  }
+  std::ranges::stable_sort(expected, {}, &std::pair<int64_t, int64_t>::first);
+
+  ASSERT_EQ(ts->nrows(), expected.size());
+  for (size_t i{}; i < expected.size(); ++i) {
+    ASSERT_EQ((*ts)[i], expected[i].first);
+    ASSERT_EQ((*venue)[i], expected[i].second);
+  }
+}
+
+TEST(MergeSortedTest, RankSplitsMergeIndependently) {
+  std::vector<std::vector<int64_t>> keys{
+      {0, 0, 1, 5, 5, 5, 8}, {1, 2, 5, 9}, {}, {3, 3, 3, 3, 4}};
+  std::vector<std::span<const int64_t>> runs(keys.begin(), keys.end());
+  const size_t total{16};
+
+  std::vector<uint32_t> sources(total);
+  std::vector<size_t> rows(total);
+  std::vector<size_t> previous(runs.size(), 0);
+  for (size_t p{1}; p <= 4; ++p) {
+    std::vector<size_t> split{};
+    for (const auto& run : runs) {
+      split.push_back(run.size());
+    }
+    if (p < 4) {
+      split = merge::split_at_rank(runs, total * p / 4);
+    }
+
+    size_t offset{std::accumulate(previous.begin(), previous.end(), size_t{0})};
+    merge::kway(runs, previous, split, sources.data() + offset,
+                rows.data() + offset);
+    previous = split;
+  }
+
+  std::vector<int64_t> merged{};
+  for (size_t i{}; i < total; ++i) {
+    merged.push_back(keys[sources[i]][rows[i]]);
+    if (i > 0 && merged[i] == merged[i - 1]) {
+      EXPECT_LE(sources[i - 1], sources[i]);
+    }
+  }
+  EXPECT_TRUE(std::ranges::is_sorted(merged));
+}
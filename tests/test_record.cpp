@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "dataframe.h"
+
+using namespace df;
+
+namespace {
+struct Quote {
+  int64_t ts{};
+  double bid{};
+  double ask{};
+  std::string venue;
+};
+}  // namespace
+
+TEST(RecordTest, StructsRoundTripThroughColumns) {
+  std::vector<Quote> quotes{};
+  for (int64_t i{}; i < 5000; ++i) {
+    quotes.push_back({i, 100.0 + i, 100.5 + i, i % 3 == 0 ? "" : "XNAS"});
+  }
+  quotes[7].bid = utils::get_null<double>();
+
+  DataFrame frame{DataFrame::from_structs<Quote>(
+      quotes, field<&Quote::ts>("ts"), field<&Quote::bid>("bid"),
+      field<&Quote::venue>("venue"))};
+
+  EXPECT_EQ(frame.shape(), (std::pair<size_t, size_t>{5000, 3}));
+  EXPECT_EQ(frame.column_names(),
+            (std::vector<std::string>{"ts", "bid", "venue"}));
+  EXPECT_EQ(frame.get_column<double>("bid")->get_null_count(), 1);
+  EXPECT_EQ(frame.get_column<std::string>("venue")->get_null_count(), 1667);
+  EXPECT_EQ(frame.maximum<int64_t>("ts"), 4999);
+  EXPECT_EQ((*frame.get_column<double>("bid"))[4999], 5099.0);
+
+  frame.add_column<double>("ask", std::vector<double>(5000, 1.0));
+  std::vector<Quote> back{frame.to_structs<Quote>(
+      field<&Quote::ts>("ts"), field<&Quote::bid>("bid"),
+      field<&Quote::ask>("ask"), field<&Quote::venue>("venue"))};
+
+  ASSERT_EQ(back.size(), quotes.size());
+  for (size_t i{}; i < back.size(); ++i) {
+    EXPECT_EQ(back[i].ts, quotes[i].ts);
+    EXPECT_EQ(back[i].venue, quotes[i].venue);
+    EXPECT_EQ(back[i].ask, 1.0);
+  }
+  EXPECT_TRUE(utils::is_null(back[7].bid));
+  EXPECT_EQ(back[8].bid, 108.0);
+}
+
+TEST(RecordTest, RejectsBadMappings) {
+  std::vector<Quote> quotes(3);
+  EXPECT_THROW(DataFrame::from_structs<Quote>(quotes, field<&Quote::bid>("x"),
+                                              field<&Quote::ask>("x")),
+               std::invalid_argument);
+
+  DataFrame frame{DataFrame::from_structs<Quote>(quotes,
+                                                 field<&Quote::ts>("ts"))};
+  EXPECT_THROW(frame.to_structs<Quote>(field<&Quote::bid>("ts")),
+               std::invalid_argument);
+  EXPECT_THROW(frame.to_structs<Quote>(field<&Quote::bid>("bid")),
+               std::invalid_argument);
+  EXPECT_TRUE(DataFrame::from_structs<Quote>({}, field<&Quote::ts>("ts"))
+                  .to_structs<Quote>(field<&Quote::ts>("ts"))
+                  .empty());
+}
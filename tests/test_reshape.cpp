@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "dataframe.h"
+
+using namespace df;
+
+namespace {
+template <Storable T>
+std::vector<T> values_of(const DataFrame& df, const std::string& name) {
+  const Column<T>* col{df.get_column<T>(name)};
+  return std::vector<T>(col->begin(), col->end());
+}
+}  // namespace
+
+TEST(ReshapeTest, PivotAndMeltRoundTrip) {
+  DataFrame quotes{};
+  quotes.add_column<int64_t>("ts", {1, 1, 2, 2, 3});
+  quotes.add_column<std::string>("symbol", {"x", "y", "x", "y", "y"});
+  quotes.add_column<double>("price", {1.0, 2.0, 1.5, 2.5, 3.0});
+
+  DataFrame wide{quotes.pivot("ts", "symbol", "price")};
+  EXPECT_EQ(wide.column_names(), (std::vector<std::string>{"ts", "x", "y"}));
+  EXPECT_EQ(wide.nrows(), 3);
+  EXPECT_EQ(values_of<double>(wide, "y"),
+            (std::vector<double>{2.0, 2.5, 3.0}));
+  EXPECT_TRUE(utils::is_null((*wide.get_column<double>("x"))[2]));
+
+  DataFrame tall{wide.melt({"ts"}, {}, "symbol", "price")};
+  EXPECT_EQ(tall.nrows(), 6);
+  EXPECT_EQ(values_of<int64_t>(tall, "ts"),
+            (std::vector<int64_t>{1, 2, 3, 1, 2, 3}));
+  EXPECT_EQ(values_of<std::string>(tall, "symbol"),
+            (std::vector<std::string>{"x", "x", "x", "y", "y", "y"}));
+  EXPECT_DOUBLE_EQ((*tall.get_column<double>("price"))[4], 2.5);
+
+  quotes.add_row(std::unordered_map<std::string, RowVariant>{
+      {"ts", int64_t{3}}, {"symbol", std::string{"y"}}, {"price", 4.0}});
+  EXPECT_THROW(quotes.pivot("ts", "symbol", "price"), std::invalid_argument);
+  EXPECT_THROW(quotes.melt({"ts"}), std::invalid_argument);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+#include "dataframe.h"
+#include "rolling.h"
+
+using namespace df;
+
+class RollingTest : public ::testing::Test {
+ protected:
+  std::vector<double> x{};
+  std::vector<double> y{};
+  std::vector<size_t> order{};
+
+  void SetUp() override {
+    std::mt19937 gen(11);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    for (size_t i{}; i < 500; ++i) {
+      x.push_back(100.0 + dist(gen));
+      y.push_back(0.5 * x.back() + dist(gen));
+      order.push_back(i);
+    }
+  }
+
+  // recomputes one window from scratch
+  double naive(size_t begin, size_t end, RollingStat stat) {
+    double n{static_cast<double>(end - begin)};
+    double mx{std::accumulate(x.begin() + begin, x.begin() + end, 0.0) / n};
+    double my{std::accumulate(y.begin() + begin, y.begin() + end, 0.0) / n};
+
+    double sxx{};
+    double syy{};
+    double sxy{};
+    for (size_t i{begin}; i < end; ++i) {
+      sxx += (x[i] - mx) * (x[i] - mx);
+      syy += (y[i] - my) * (y[i] - my);
+      sxy += (x[i] - mx) * (y[i] - my);
+    }
+
+    switch (stat) {
+      case RollingStat::Covariance:
+        return sxy / (n - 1);
+      case RollingStat::Correlation:
+        return sxy / std::sqrt(sxx * syy);
+      case RollingStat::Beta:
+        return sxy / sxx;
+    }
+    return 0.0;
+  }
+};
+
+TEST_F(RollingTest, RowWindowsMatchRecomputation) {
+  const size_t window{20};
+  for (auto stat : {RollingStat::Covariance, RollingStat::Correlation,
+                    RollingStat::Beta}) {
+    std::vector<double> out(x.size());
+    rolling::by_rows(x, y, order, window, 2, stat, out);
+
+    EXPECT_TRUE(utils::is_null(out[0]));
+    for (size_t i{1}; i < x.size(); ++i) {
+      size_t begin{i + 1 >= window ? i + 1 - window : 0};
+      EXPECT_NEAR(out[i], naive(begin, i + 1, stat), 1e-9) << "row " << i;
+    }
+  }
+}
+
+TEST_F(RollingTest, TimeWindowsAndNulls) {
+  // one row per 10 ticks, a 50 tick window holds 5 rows
+  std::vector<int64_t> times(x.size());
+  for (size_t i{}; i < times.size(); ++i) {
+    times[i] = static_cast<int64_t>(i) * 10;
+  }
+
+  std::vector<double> out(x.size());
+  rolling::by_time(x, y, times, order, 50, 2, RollingStat::Beta, out);
+  for (size_t i{4}; i < x.size(); ++i) {
+    EXPECT_NEAR(out[i], naive(i - 4, i + 1, RollingStat::Beta), 1e-9);
+  }
+
+  // a null pair is skipped and min_periods applies to valid pairs only
+  x[1] = utils::get_null<double>();
+  rolling::by_rows(x, y, order, 3, 3, RollingStat::Covariance, out);
+  EXPECT_TRUE(utils::is_null(out[2]));
+  EXPECT_TRUE(utils::is_null(out[3]));
+  EXPECT_FALSE(utils::is_null(out[4]));
+
+  std::reverse(times.begin(), times.end());
+  EXPECT_THROW(
+      rolling::by_time(x, y, times, order, 50, 2, RollingStat::Beta, out),
+      std::invalid_argument);
+}
+
+TEST_F(RollingTest, FrameWindowsFollowGroupsAndSkipNulls) {
+  // three interleaved groups, nulls on either side inside their windows
+  const size_t n{60};
+  std::vector<std::string> keys(n);
+  std::vector<int64_t> times(n);
+  for (size_t i{}; i < n; ++i) {
+    keys[i] = std::string(1, static_cast<char>('a' + i % 3));
+    times[i] = static_cast<int64_t>(i) * 10;
+  }
+  x.resize(n);
+  y.resize(n);
+  for (size_t i : {7, 8, 22, 40}) {
+    (i % 2 == 0 ? x : y)[i] = utils::get_null<double>();
+  }
+
+  DataFrame df{};
+  df.add_column<std::string>("key", keys);
+  df.add_column<int64_t>("ts", times);
+  df.add_column<double>("x", x);
+  df.add_column<double>("y", y);
+
+  // rows of the same group in a window, nulls dropped
+  auto expected = [&](size_t row, auto in_window, size_t min_periods) {
+    std::vector<size_t> kept{};
+    for (size_t j{}; j <= row; ++j) {
+      if (keys[j] == keys[row] && in_window(j) &&
+          !utils::is_null(x[j]) && !utils::is_null(y[j])) {
+        kept.push_back(j);
+      }
+    }
+    if (kept.size() < min_periods) {
+      return utils::get_null<double>();
+    }
+
+    double mx{}, my{};
+    for (size_t j : kept) {
+      mx += x[j] / kept.size();
+      my += y[j] / kept.size();
+    }
+    double sxy{};
+    for (size_t j : kept) {
+      sxy += (x[j] - mx) * (y[j] - my);
+    }
+    return sxy / (kept.size() - 1);
+  };
+
+  df.rolling("x", "y", RollingStat::Covariance, 4, "rows", {"key"}, 3);
+  df.rolling("x", "y", RollingStat::Covariance, "ts", 95, "time", {"key"});
+  const Column<double>* by_rows{df.get_column<double>("rows")};
+  const Column<double>* by_time{df.get_column<double>("time")};
+
+  for (size_t i{}; i < n; ++i) {
+    // the 4 most recent rows of the group, the last 95 ticks
+    double rows{expected(i, [&](size_t j) { return j + 12 > i; }, 3)};
+    double time{expected(
+        i, [&](size_t j) { return times[j] > times[i] - 95; }, 2)};
+
+    if (utils::is_null(rows)) {
+      EXPECT_TRUE(utils::is_null((*by_rows)[i])) << "row " << i;
+    } else {
+      EXPECT_NEAR((*by_rows)[i], rows, 1e-9) << "row " << i;
+    }
+    if (utils::is_null(time)) {
+      EXPECT_TRUE(utils::is_null((*by_time)[i])) << "row " << i;
+    } else {
+      EXPECT_NEAR((*by_time)[i], time, 1e-9) << "row " << i;
+    }
+  }
+
+  // group b reaches 3 rows at row 7, but row 7 is null so it waits for 10
+  EXPECT_TRUE(utils::is_null((*by_rows)[7]));
+  EXPECT_FALSE(utils::is_null((*by_rows)[10]));
+
+  EXPECT_THROW(df.rolling("x", "key", RollingStat::Beta, 4, "bad"),
+               std::invalid_argument);
+  EXPECT_THROW(df.rolling("x", "y", RollingStat::Beta, "x", 10, "bad"),
+               std::invalid_argument);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "column.h"
+#include "groupby.h"
+#include "sketch.h"
+
+using namespace df;
+
+class SketchTest : public ::testing::Test {
+ protected:
+  std::vector<double> make_values(size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1000.0);
+
+    std::vector<double> values(n);
+    for (auto& value : values) {
+      value = dist(gen);
+    }
+    return values;
+  }
+};
+
+TEST_F(SketchTest, HyperLogLogEstimatesWithinError) {
+  HyperLogLog hll{};
+  const int64_t n{100000};
+  for (int64_t i{}; i < n; ++i) {
+    hll.add(i);
+    hll.add(i);  // duplicates do not count
+  }
+
+  EXPECT_NEAR(hll.estimate(), static_cast<double>(n), n * 0.03);
+  EXPECT_THROW(HyperLogLog{2}, std::invalid_argument);
+}
+
+TEST_F(SketchTest, HyperLogLogMergesAndRoundTrips) {
+  HyperLogLog monday{};
+  HyperLogLog tuesday{};
+  for (int64_t i{}; i < 50000; ++i) {
+    monday.add(i);
+    tuesday.add(i + 25000);  // half overlaps with monday
+  }
+
+  auto restored{HyperLogLog::from_bytes(tuesday.to_bytes())};
+  EXPECT_EQ(restored.estimate(), tuesday.estimate());
+
+  monday.merge(restored);
+  EXPECT_NEAR(monday.estimate(), 75000.0, 75000.0 * 0.03);
+
+  HyperLogLog coarse{10};
+  EXPECT_THROW(monday.merge(coarse), std::invalid_argument);
+}
+
+TEST_F(SketchTest, TDigestQuantilesWithinError) {
+  std::vector<double> values{make_values(100000, 42)};
+
+  TDigest digest{};
+  for (const auto& value : values) {
+    digest.add(value);
+  }
+
+  std::ranges::sort(values);
+  for (double q : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+    double exact{values[static_cast<size_t>(q * (values.size() - 1))]};
+    EXPECT_NEAR(digest.quantile(q), exact, 5.0) << "q = " << q;
+  }
+
+  EXPECT_THROW(digest.quantile(1.5), std::invalid_argument);
+  EXPECT_THROW(TDigest{}.quantile(0.5), std::invalid_argument);
+}
+
+TEST_F(SketchTest, TDigestMergesAndRoundTrips) {
+  std::vector<double> first{make_values(50000, 1)};
+  std::vector<double> second{make_values(50000, 2)};
+
+  TDigest a{};
+  TDigest b{};
+  for (size_t i{}; i < first.size(); ++i) {
+    a.add(first[i]);
+    b.add(second[i]);
+  }
+
+  auto restored{TDigest::from_bytes(b.to_bytes())};
+  EXPECT_EQ(restored.quantile(0.9), b.quantile(0.9));
+
+  a.merge(restored);
+  EXPECT_EQ(a.count(), 100000.0);
+  EXPECT_NEAR(a.quantile(0.5), 500.0, 10.0);
+}
+
+TEST_F(SketchTest, ColumnApproximateMethods) {
+  Column<double> col{make_values(20000, 7)};
+  col.append(utils::get_null<double>());
+
+  EXPECT_NEAR(static_cast<double>(col.approx_nunique()),
+              static_cast<double>(col.nunique()), col.nunique() * 0.03);
+  EXPECT_NEAR(col.approx_percentile(0.5), col.percentile(0.5), 10.0);
+
+  Column<std::string> strings{};
+  EXPECT_THROW(strings.approx_percentile(0.5), std::invalid_argument);
+}
+
+TEST_F(SketchTest, GroupSketchesRoundTripThroughFilesAndMerge) {
+  std::vector<double> values{make_values(30000, 11)};
+  std::vector<std::string> keys(values.size());
+  for (size_t i{}; i < keys.size(); ++i) {
+    keys[i] = i % 3 == 0 ? "x" : "y";
+  }
+  values[5] = utils::get_null<double>();
+
+  DataFrame df{};
+  df.add_column<std::string>("key", keys);
+  df.add_column<double>("value", values);
+  GroupBy groups{df.groupby({"key"})};
+
+  const std::string dir{::testing::TempDir()};
+  HyperLogLog distinct{};
+  TDigest digest{};
+  std::vector<HyperLogLog> hlls{groups.distinct_sketches("value")};
+  std::vector<TDigest> digests{groups.quantile_sketches("value")};
+  for (size_t g{}; g < groups.ngroups(); ++g) {
+    std::string stem{dir + "group_" + std::to_string(g)};
+    hlls[g].to_binary(stem + ".hll");
+    digests[g].to_binary(stem + ".tdigest");
+
+    HyperLogLog hll{HyperLogLog::from_binary(stem + ".hll")};
+    TDigest restored{TDigest::from_binary(stem + ".tdigest")};
+    EXPECT_EQ(hll.estimate(), hlls[g].estimate());
+    EXPECT_EQ(restored.quantile(0.5), digests[g].quantile(0.5));
+
+    distinct.merge(hll);
+    digest.merge(restored);
+  }
+
+  // merged group sketches describe the whole column
+  Column<double> column{values};
+  EXPECT_EQ(distinct.estimate(), column.distinct_sketch().estimate());
+  EXPECT_EQ(digest.count(), static_cast<double>(values.size() - 1));
+  EXPECT_NEAR(digest.quantile(0.5), column.percentile(0.5), 10.0);
+  EXPECT_THROW(TDigest::from_binary(dir + "missing.tdigest"),
+               std::runtime_error);
+}
+
+TEST_F(SketchTest, TDigestReadsConstDigestWithoutCompressing) {
+  TDigest digest{};
+  for (const auto& value : make_values(200, 3)) {
+    digest.add(value);  // below the buffer limit, nothing compressed yet
+  }
+
+  const TDigest& view{digest};
+  double median{view.quantile(0.5)};
+  std::vector<std::byte> bytes{view.to_bytes()};
+
+  digest.compress();
+  EXPECT_EQ(digest.quantile(0.5), median);
+  EXPECT_EQ(digest.to_bytes(), bytes);
+}
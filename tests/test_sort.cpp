@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+#include "sort.h"
+
+using namespace df;
+
+class SortTest : public ::testing::Test {
+ protected:
+  std::mt19937 gen{5};
+
+  // stable reference ordering
+  template <typename T>
+  std::vector<size_t> reference(const std::vector<T>& values, bool ascending) {
+    std::vector<size_t> indices(values.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    std::ranges::stable_sort(indices, [&](size_t a, size_t b) {
+      return ascending ? values[a] < values[b] : values[b] < values[a];
+    });
+    return indices;
+  }
+};
+
+TEST_F(SortTest, AdaptiveMatchesStableSortOnDisorderPatterns) {
+  const size_t n{20000};
+  std::uniform_int_distribution<int64_t> small(0, 50);
+
+  std::vector<std::vector<int64_t>> patterns(4);
+  for (size_t i{}; i < n; ++i) {
+    patterns[0].push_back(static_cast<int64_t>(i) / 3);  // sorted, ties
+    patterns[1].push_back(static_cast<int64_t>(n - i));  // reversed
+    patterns[2].push_back(small(gen));                   // random
+    patterns[3].push_back(static_cast<int64_t>(i));
+  }
+
+  // delayed bursts, a few rows arriving late every thousand
+  for (size_t i{1000}; i + 20 < n; i += 1000) {
+    std::rotate(patterns[3].begin() + i, patterns[3].begin() + i + 15,
+                patterns[3].begin() + i + 20);
+  }
+
+  for (const auto& values : patterns) {
+    for (bool ascending : {true, false}) {
+      EXPECT_EQ(sort::argsort(values, ascending),
+                reference(values, ascending));
+    }
+  }
+}
+
+TEST_F(SortTest, NodePowerAndSortedCheck) {
+  EXPECT_EQ(sort::node_power(0, 4, 8, 8), 1);
+  EXPECT_EQ(sort::node_power(0, 2, 4, 8), 2);
+  EXPECT_EQ(sort::node_power(4, 6, 8, 8), 2);
+
+  EXPECT_TRUE(sort::is_sorted(std::vector<double>{1.0, 1.0, 2.0}, true));
+  EXPECT_FALSE(sort::is_sorted(std::vector<double>{1.0, 1.0, 2.0}, false));
+  EXPECT_TRUE(sort::is_sorted(std::vector<std::string>{"b", "a"}, false));
+}
+
+TEST_F(SortTest, StringArgsortMatchesStableSort) {
+  std::uniform_int_distribution<int> length(0, 20);
+  std::uniform_int_distribution<int> byte(0, 3);
+
+  std::vector<std::string> values{};
+  for (size_t i{}; i < 5000; ++i) {
+    if (i % 3 == 0) {
+      values.push_back("ORD-2024-" + std::to_string(i % 700));  // shared
+      continue;
+    }
+    std::string value(length(gen), 'x');
+    for (auto& c : value) {
+      c = "ab\0\xff"[byte(gen)];
+    }
+    values.push_back(value);
+  }
+
+  for (bool ascending : {true, false}) {
+    EXPECT_EQ(sort::argsort(values, ascending), reference(values, ascending));
+  }
+
+  EXPECT_EQ(sort::prefix_key("ab", 0), 0x6162000000000000ULL);
+  EXPECT_EQ(sort::prefix_key("0123456789", 8), 0x3839000000000000ULL);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "dataframe.h"
+
+using namespace df;
+
+namespace {
+template <Storable T>
+std::vector<T> values_of(const DataFrame& df, const std::string& name) {
+  const Column<T>* col{df.get_column<T>(name)};
+  return std::vector<T>(col->begin(), col->end());
+}
+}  // namespace
+
+TEST(BinningTest, CutAndQcutAddCodeColumns) {
+  const int64_t null{utils::get_null<int64_t>()};
+  DataFrame df{};
+  df.add_column<int64_t>("qty", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, null, 20});
+  df.add_column<std::string>("name", std::vector<std::string>(12, "x"));
+
+  df.cut("qty", {0.0, 5.0, 10.0}, "bucket");
+  EXPECT_EQ(values_of<int64_t>(df, "bucket"),
+            (std::vector<int64_t>{0, 0, 0, 0, 0, 1, 1, 1, 1, 1, null, null}));
+  EXPECT_EQ(df.get_column<int64_t>("bucket")->get_null_count(), 2);
+
+  df.qcut("qty", 2, "half");
+  std::vector<int64_t> halves{values_of<int64_t>(df, "half")};
+  EXPECT_EQ(std::ranges::count(halves, 0), 5);  // the median opens bin 1
+  EXPECT_EQ(std::ranges::count(halves, 1), 6);
+  EXPECT_EQ(halves[10], null);
+  EXPECT_EQ(df.ncols(), 4);
+
+  EXPECT_THROW(df.cut("missing", {0.0, 1.0}, "out"), std::invalid_argument);
+  EXPECT_THROW(df.cut("name", {0.0, 1.0}, "out"), std::invalid_argument);
+  EXPECT_THROW(df.cut("qty", {1.0, 0.0}, "out"), std::invalid_argument);
+  EXPECT_THROW(df.qcut("qty", 0, "out"), std::invalid_argument);
+  EXPECT_THROW(df.qcut("qty", 2, "half"), std::runtime_error);
+}
+
+namespace {
+// two pass sample covariance over rows where both inputs are valid
+double naive_cov(const std::vector<double>& x, const std::vector<double>& y,
+                 const std::vector<bool>& use, bool normalize) {
+  double sx{}, sy{};
+  size_t m{};
+  for (size_t r{}; r < x.size(); ++r) {
+    if (use[r] && !utils::is_null(x[r]) && !utils::is_null(y[r])) {
+      sx += x[r];
+      sy += y[r];
+      ++m;
+    }
+  }
+  if (m < 2) {
+    return utils::get_null<double>();
+  }
+
+  double mx{sx / m}, my{sy / m}, cxy{}, cxx{}, cyy{};
+  for (size_t r{}; r < x.size(); ++r) {
+    if (use[r] && !utils::is_null(x[r]) && !utils::is_null(y[r])) {
+      cxy += (x[r] - mx) * (y[r] - my);
+      cxx += (x[r] - mx) * (x[r] - mx);
+      cyy += (y[r] - my) * (y[r] - my);
+    }
+  }
+  if (!normalize) {
+    return cxy / (m - 1);
+  }
+  return cxx * cyy > 0.0 ? cxy / std::sqrt(cxx * cyy)
+                         : utils::get_null<double>();
+}
+
+void expect_matches_naive(const DataFrame& result,
+                          const std::vector<std::string>& names,
+                          const std::vector<std::vector<double>>& inputs,
+                          const std::vector<bool>& use, bool normalize) {
+  ASSERT_EQ(result.nrows(), names.size());
+  EXPECT_EQ(values_of<std::string>(result, "column"), names);
+  for (size_t j{}; j < names.size(); ++j) {
+    std::vector<double> got{values_of<double>(result, names[j])};
+    for (size_t i{}; i < names.size(); ++i) {
+      double expected{naive_cov(inputs[i], inputs[j], use, normalize)};
+      if (utils::is_null(expected)) {
+        EXPECT_TRUE(utils::is_null(got[i])) << names[i] << " " << names[j];
+      } else {
+        EXPECT_NEAR(got[i], expected, 1e-9 * (1.0 + std::abs(expected)))
+            << names[i] << " " << names[j];
+      }
+    }
+  }
+}
+}  // namespace
+
+class CovarianceTest : public ::testing::Test {
+ protected:
+  const double null{utils::get_null<double>()};
+  std::vector<std::string> names{"x", "y", "z", "flat"};
+  std::vector<std::vector<double>> inputs{
+      {1.0, 2.5, null, 4.0, 5.5, 7.0, 8.0, 3.0},
+      {2.0, null, 1.0, 6.5, 5.0, 9.0, 4.0, 1.5},
+      {1e6 + 1, 1e6 + 3, 1e6 + 2, 1e6 + 8, null, 1e6 + 5, 1e6 + 4, 1e6 + 9},
+      {3.0, 3.0, 3.0, 3.0, 3.0, 3.0, null, 3.0}};
+  DataFrame df{};
+
+  void SetUp() override {
+    df.add_column<std::string>("label", std::vector<std::string>(8, "row"));
+    for (size_t c{}; c < names.size(); ++c) {
+      df.add_column<double>(names[c], inputs[c]);
+    }
+  }
+
+  std::vector<bool> complete_rows() const {
+    std::vector<bool> use(8, true);
+    for (const auto& input : inputs) {
+      for (size_t r{}; r < use.size(); ++r) {
+        use[r] = use[r] && !utils::is_null(input[r]);
+      }
+    }
+    return use;
+  }
+};
+
+TEST_F(CovarianceTest, PairwiseMatchesTwoPass) {
+  std::vector<bool> all(8, true);
+  expect_matches_naive(df.cov(), names, inputs, all, false);
+  expect_matches_naive(df.corr(), names, inputs, all, true);
+}
+
+TEST_F(CovarianceTest, CompleteRowsMatchesTwoPass) {
+  std::vector<bool> use{complete_rows()};
+  expect_matches_naive(df.cov(NullHandling::CompleteRows), names, inputs, use,
+                       false);
+  expect_matches_naive(df.corr(NullHandling::CompleteRows), names, inputs, use,
+                       true);
+}
+
+TEST_F(CovarianceTest, ConstantColumnCorrelationIsNull) {
+  DataFrame result{df.corr()};
+  std::vector<double> flat{values_of<double>(result, "flat")};
+  EXPECT_TRUE(std::ranges::all_of(flat, utils::is_null<double>));
+  EXPECT_NEAR(values_of<double>(result, "x")[0], 1.0, 1e-12);
+}
+
+TEST_F(CovarianceTest, LabelColumnAvoidsInputNames) {
+  DataFrame clash{};
+  clash.add_column<double>("column", {1.0, 2.0, 4.0});
+  clash.add_column<double>("column_label", {2.0, 1.0, 0.0});
+
+  DataFrame result{clash.cov()};
+  EXPECT_EQ(result.ncols(), 3);
+  EXPECT_EQ(values_of<std::string>(result, "column_label_label"),
+            (std::vector<std::string>{"column", "column_label"}));
+  EXPECT_NEAR(values_of<double>(result, "column")[0], 7.0 / 3.0, 1e-12);
+  EXPECT_NEAR(values_of<double>(result, "column")[1], -1.5, 1e-12);
+}
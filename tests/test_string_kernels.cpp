@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "string_kernels.h"
+
+using namespace df;
+
+template <typename Strings>
+class StringKernelTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> values{"AAPL.O", "", "msft.oq", "AAPL.N",
+                                  "BRK.B.N", "goog"};
+  Strings column{values};
+};
+
+using StringColumnTypes =
+    ::testing::Types<Column<std::string>, CompactStringColumn>;
+TYPED_TEST_SUITE(StringKernelTest, StringColumnTypes);
+
+TYPED_TEST(StringKernelTest, PredicatesSelectRows) {
+  EXPECT_EQ(strings::equals(this->column, "goog"), (std::vector<size_t>{5}));
+  EXPECT_EQ(strings::starts_with(this->column, "AAPL"),
+            (std::vector<size_t>{0, 3}));
+  EXPECT_EQ(strings::ends_with(this->column, ".N"),
+            (std::vector<size_t>{3, 4}));
+  EXPECT_EQ(strings::contains(this->column, "."),
+            (std::vector<size_t>{0, 2, 3, 4}));
+  EXPECT_EQ(strings::contains(this->column, "K.B."),
+            (std::vector<size_t>{4}));
+  EXPECT_EQ(strings::starts_with(this->column, ""),
+            (std::vector<size_t>{0, 2, 3, 4, 5}));  // nulls never match
+}
+
+TYPED_TEST(StringKernelTest, TransformsMapRows) {
+  auto as_vector = [](const auto& column) {
+    return std::vector(column.begin(), column.end());
+  };
+
+  EXPECT_EQ(as_vector(strings::length(this->column)),
+            (std::vector<int64_t>{6, utils::get_null<int64_t>(), 7, 6, 7, 4}));
+  EXPECT_EQ(as_vector(strings::upper(this->column)),
+            (std::vector<std::string>{"AAPL.O", "", "MSFT.OQ", "AAPL.N",
+                                      "BRK.B.N", "GOOG"}));
+  EXPECT_EQ(as_vector(strings::lower(this->column))[0], "aapl.o");
+  EXPECT_EQ(as_vector(strings::slice(this->column, 1, 3)),
+            (std::vector<std::string>{"APL", "", "sft", "APL", "RK.", "oog"}));
+  EXPECT_EQ(as_vector(strings::split_part(this->column, ".", 1)),
+            (std::vector<std::string>{"O", "", "oq", "N", "B", ""}));
+  EXPECT_EQ(as_vector(strings::split_part(this->column, ".", 0))[4], "BRK");
+}
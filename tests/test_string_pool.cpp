@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "dataframe.h"
+#include "string_pool.h"
+
+using namespace df;
+
+TEST(StringPoolTest, InternsOnceAcrossThreads) {
+  StringPool pool{};
+  std::vector<std::string> symbols{};
+  for (size_t i{}; i < 2000; ++i) {
+    symbols.push_back("SYM" + std::to_string(i));
+  }
+  symbols.push_back(std::string(100000, 'x'));  // spills out of the arena
+
+  std::vector<std::vector<int64_t>> ids(4);
+  {
+    std::vector<std::jthread> workers{};
+    for (size_t t{}; t < ids.size(); ++t) {
+      workers.emplace_back([&, t] {
+        for (const auto& symbol : symbols) {
+          ids[t].push_back(pool.intern(symbol));
+        }
+      });
+    }
+  }
+
+  EXPECT_EQ(pool.size(), symbols.size());
+  for (size_t t{1}; t < ids.size(); ++t) {
+    EXPECT_EQ(ids[t], ids[0]);
+  }
+  for (size_t i{}; i < symbols.size(); ++i) {
+    EXPECT_EQ(pool.view(ids[0][i]), symbols[i]);
+  }
+
+  EXPECT_TRUE(utils::is_null(pool.intern("")));
+  EXPECT_TRUE(pool.view(utils::get_null<int64_t>()).empty());
+  EXPECT_THROW(pool.view(int64_t{1} << 40), std::out_of_range);
+}
+
+TEST(StringPoolTest, InternedColumnsJoinOnIds) {
+  DataFrame quotes{};
+  quotes.add_column<std::string>("symbol", {"AAPL", "MSFT", ""});
+  quotes.add_column<double>("bid", {1.0, 2.0, 3.0});
+
+  DataFrame trades{};
+  trades.add_column<std::string>("symbol", {"MSFT", "AAPL", "MSFT"});
+  trades.add_column<int64_t>("qty", {10, 20, 30});
+
+  quotes.intern("symbol");
+  trades.intern("symbol");
+  ASSERT_NE(quotes.get_column<int64_t>("symbol"), nullptr);
+
+  DataFrame joined{DataFrame::inner_join(trades, quotes, {"symbol"})};
+  EXPECT_EQ(joined.nrows(), 3);
+
+  joined.resolve("symbol");
+  const Column<std::string>* symbols{joined.get_column<std::string>("symbol")};
+  ASSERT_NE(symbols, nullptr);
+  EXPECT_EQ(std::vector<std::string>(symbols->begin(), symbols->end()),
+            (std::vector<std::string>{"MSFT", "AAPL", "MSFT"}));
+
+  quotes.resolve("symbol");
+  EXPECT_EQ((*quotes.get_column<std::string>("symbol"))[2], "");
+  EXPECT_THROW(quotes.resolve("symbol"), std::invalid_argument);
+}
+
+TEST(StringPoolTest, ResolveOnlyAcceptsInternedColumns) {
+  DataFrame trades{};
+  trades.add_column<std::string>("symbol", {"MSFT", "AAPL", "MSFT", "IBM"});
+  trades.add_column<int64_t>("qty", {10, 20, 30, 40});
+
+  EXPECT_THROW(trades.resolve("qty"), std::invalid_argument);
+  trades.intern("symbol");
+  ASSERT_TRUE(trades.get_column<int64_t>("symbol")->is_interned());
+  EXPECT_FALSE(trades.get_column<int64_t>("qty")->is_interned());
+
+  // row copies of an interned column stay resolvable
+  trades.sort_by("qty");
+  std::vector<DataFrame> copies{};
+  copies.push_back(trades);
+  copies.push_back(trades.take({0, 3}));
+  copies.push_back(trades.slice(0, 2));
+  copies.push_back(DataFrame::merge_sorted({trades, trades}, "qty"));
+  copies.push_back(trades.melt({"symbol"}, {"qty"}, "field", "value"));
+  for (auto& copy : copies) {
+    copy.resolve("symbol");
+    EXPECT_EQ((*copy.get_column<std::string>("symbol"))[0], "MSFT");
+  }
+
+  // plain int64 data under the same name is not accepted
+  trades.drop_column("symbol");
+  trades.add_column<int64_t>("symbol", {1, 2, 3, 4});
+  EXPECT_THROW(trades.resolve("symbol"), std::invalid_argument);
+}
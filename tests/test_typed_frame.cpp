@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "typed_frame.h"
+
+using namespace df;
+
+namespace {
+using Trades = TypedFrame<Col<"ts", int64_t>, Col<"px", double>,
+                          Col<"venue", std::string>>;
+
+Trades sample() {
+  Trades trades{};
+  trades.append(3, 101.5, "B");
+  trades.append(1, 100.0, "A");
+  trades.append(4, utils::get_null<double>(), "A");
+  trades.append(2, 99.5, "C");
+  return trades;
+}
+}  // namespace
+
+TEST(TypedFrameTest, ColumnsAreResolvedAtCompileTime) {
+  static_assert(Trades::has<"px">);
+  static_assert(!Trades::has<"qty">);
+  static_assert(std::is_same_v<Trades::value_type_of<"venue">, std::string>);
+  static_assert(Trades::ncols() == 3);
+
+  Trades trades{sample()};
+  EXPECT_EQ(trades.nrows(), 4);
+  EXPECT_EQ(trades.values<"ts">()[2], 4);
+  EXPECT_EQ(trades.column<"px">().get_null_count(), 1);
+  EXPECT_EQ(trades.count<"px">(), 3);
+  EXPECT_DOUBLE_EQ(trades.sum<"px">(), 301.0);
+  EXPECT_EQ(trades.maximum<"venue">(), "C");
+  EXPECT_EQ(trades.minimum<"ts">(), 1);
+}
+
+TEST(TypedFrameTest, SortsAndFiltersEveryColumnTogether) {
+  Trades trades{sample()};
+  trades.sort_by<"ts">();
+
+  auto ts{trades.values<"ts">()};
+  EXPECT_EQ(std::vector<int64_t>(ts.begin(), ts.end()),
+            (std::vector<int64_t>{1, 2, 3, 4}));
+  EXPECT_EQ(trades.values<"venue">()[0], "A");
+  EXPECT_EQ(trades.values<"px">()[1], 99.5);
+
+  Trades cheap{trades.filter<"px">([](double px) { return px < 101.0; })};
+  EXPECT_EQ(cheap.nrows(), 2);
+  EXPECT_EQ(cheap.values<"venue">()[1], "C");
+
+  EXPECT_EQ(trades.between<"ts">(2, 3).nrows(), 2);
+  EXPECT_EQ(trades.isin<"venue">({"A"}).column<"px">().get_null_count(), 1);
+
+  trades.sort_by<"venue">(false);
+  EXPECT_EQ(trades.values<"ts">()[0], 2);
+
+  Trades picked{trades.take({3, 3, 0})};
+  EXPECT_EQ(picked.nrows(), 3);
+  EXPECT_EQ(picked.values<"ts">()[1], trades.values<"ts">()[3]);
+  EXPECT_THROW(trades.take({0, 4}), std::out_of_range);
+  EXPECT_THROW(Trades{}.take({0}), std::out_of_range);
+}
+
+TEST(TypedFrameTest, ConvertsToAndFromDataFrame) {
+  DataFrame frame{sample().to_dataframe()};
+  EXPECT_EQ(frame.shape(), (std::pair<size_t, size_t>{4, 3}));
+  EXPECT_EQ(frame.column_names(),
+            (std::vector<std::string>{"ts", "px", "venue"}));
+  EXPECT_EQ(frame.sum("px"), 301.0);
+
+  Trades copied{Trades::from_dataframe(frame)};
+  EXPECT_EQ(copied.nrows(), 4);
+  EXPECT_EQ(frame.nrows(), 4);
+
+  Trades moved{Trades::from_dataframe(std::move(frame))};
+  EXPECT_EQ(moved.to_dataframe(), copied.to_dataframe());
+
+  DataFrame wrong{};
+  wrong.add_column<double>("ts", {1.0});
+  EXPECT_THROW(Trades::from_dataframe(wrong), std::invalid_argument);
+}
+
+TEST(TypedFrameTest, ParsesCsvForTheSchema) {
+  std::string text{"ts,px,venue\n"};
+  for (int64_t i{}; i < 1000; ++i) {
+    text += std::to_string(i) + "," + (i % 10 == 0 ? "" : "100.5") + "," +
+            (i % 2 == 0 ? "\"X, Y\"" : " B ") + "\r\n";
+    if (i == 500) {
+      text += "\n";
+    }
+  }
+
+  for (size_t chunks : {1, 3, 16}) {
+    Trades trades{Trades::parse_csv(text, ',', chunks)};
+    EXPECT_EQ(trades.nrows(), 1000);
+    EXPECT_EQ(trades.values<"ts">()[999], 999);
+    EXPECT_EQ(trades.column<"px">().get_null_count(), 100);
+    EXPECT_EQ(trades.values<"venue">()[0], "X, Y");
+    EXPECT_EQ(trades.values<"venue">()[1], "B");
+  }
+
+  EXPECT_THROW(Trades::parse_csv("ts,venue,px\n1,A,2.0\n"),
+               std::invalid_argument);
+  try {
+    Trades::parse_csv("ts,px,venue\n1,2.0,A\n\n2,3.0\n", ',', 2);
+    FAIL() << "expected a malformed line";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "malformed line 4: expected 3 columns, got 2");
+  }
+  EXPECT_THROW(Trades::parse_csv("ts,px,venue\n1,2.0,A,extra\n"),
+               std::runtime_error);
+  EXPECT_THROW(read_csv<Trades>("/nonexistent/trades.csv"),
+               std::runtime_error);
+}
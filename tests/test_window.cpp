@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "dataframe.h"
+
+using namespace df;
+
+namespace {
+template <Storable T>
+std::vector<T> values_of(const DataFrame& df, const std::string& name) {
+  const Column<T>* col{df.get_column<T>(name)};
+  return std::vector<T>(col->begin(), col->end());
+}
+}  // namespace
+
+class WindowTest : public ::testing::Test {
+ protected:
+  const int64_t null{utils::get_null<int64_t>()};
+  DataFrame df{};
+
+  void SetUp() override {
+    df.add_column<std::string>("grp", {"a", "a", "a", "a", "b", "b"});
+    df.add_column<int64_t>("score", {10, 20, 20, 30, 5, null});
+    df.add_column<int64_t>("value", {1, 2, 3, 4, 5, 6});
+  }
+};
+
+TEST_F(WindowTest, RankingTies) {
+  df.row_number({"grp"}, "score", "rn");
+  df.rank({"grp"}, "score", "rk");
+  df.dense_rank({"grp"}, "score", "drk");
+
+  // ties keep row order for row_number, share a rank and leave a gap for
+  // rank, and share a rank without a gap for dense_rank
+  EXPECT_EQ(values_of<int64_t>(df, "rn"),
+            (std::vector<int64_t>{1, 2, 3, 4, 2, 1}));
+  EXPECT_EQ(values_of<int64_t>(df, "rk"),
+            (std::vector<int64_t>{1, 2, 2, 4, 2, 1}));
+  EXPECT_EQ(values_of<int64_t>(df, "drk"),
+            (std::vector<int64_t>{1, 2, 2, 3, 2, 1}));
+}
+
+TEST_F(WindowTest, RankingDescending) {
+  df.row_number({"grp"}, "score", "rn", false);
+  df.rank({"grp"}, "score", "rk", false);
+  df.dense_rank({"grp"}, "score", "drk", false);
+
+  EXPECT_EQ(values_of<int64_t>(df, "rn"),
+            (std::vector<int64_t>{4, 2, 3, 1, 1, 2}));
+  EXPECT_EQ(values_of<int64_t>(df, "rk"),
+            (std::vector<int64_t>{4, 2, 2, 1, 1, 2}));
+  EXPECT_EQ(values_of<int64_t>(df, "drk"),
+            (std::vector<int64_t>{3, 2, 2, 1, 1, 2}));
+}
+
+TEST_F(WindowTest, NullOrderKeysSortFirst) {
+  // the null sentinel is the smallest value, so nulls lead ascending order
+  // and trail descending order
+  df.rank({"grp"}, "score", "asc");
+  df.rank({"grp"}, "score", "desc", false);
+
+  EXPECT_EQ(values_of<int64_t>(df, "asc")[5], 1);
+  EXPECT_EQ(values_of<int64_t>(df, "desc")[5], 2);
+}
+
+TEST_F(WindowTest, LagAndLeadAtPartitionEdges) {
+  df.lag("value", 1, {"grp"}, "score", "prev");
+  df.lead("value", 1, {"grp"}, "score", "next");
+
+  // partition b is ordered null score first, so row 5 precedes row 4
+  EXPECT_EQ(values_of<int64_t>(df, "prev"),
+            (std::vector<int64_t>{null, 1, 2, 3, 6, null}));
+  EXPECT_EQ(values_of<int64_t>(df, "next"),
+            (std::vector<int64_t>{2, 3, 4, null, null, 5}));
+  EXPECT_EQ(df.get_column<int64_t>("prev")->get_null_count(), 2);
+}
+
+TEST_F(WindowTest, OffsetsPastPartitionSize) {
+  df.lag("value", 4, {"grp"}, "score", "far_prev");
+  df.lead("value", 10, {"grp"}, "score", "far_next");
+  df.lag("value", 0, {"grp"}, "score", "same");
+
+  EXPECT_EQ(df.get_column<int64_t>("far_prev")->get_null_count(), 6);
+  EXPECT_EQ(df.get_column<int64_t>("far_next")->get_null_count(), 6);
+  EXPECT_EQ(values_of<int64_t>(df, "same"), values_of<int64_t>(df, "value"));
+}
+
+TEST_F(WindowTest, EmptyPartitionListIsOneWindow) {
+  df.row_number({}, "score", "rn");
+  df.lag("value", 1, {}, "", "prev");
+  df.first_value("value", {}, "score", "first");
+  df.last_value("value", {}, "score", "last");
+
+  EXPECT_EQ(values_of<int64_t>(df, "rn"),
+            (std::vector<int64_t>{3, 4, 5, 6, 2, 1}));
+  EXPECT_EQ(values_of<int64_t>(df, "prev"),
+            (std::vector<int64_t>{null, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(values_of<int64_t>(df, "first"), std::vector<int64_t>(6, 6));
+  EXPECT_EQ(values_of<int64_t>(df, "last"), std::vector<int64_t>(6, 4));
+}
+
+TEST_F(WindowTest, FirstAndLastValuePerPartition) {
+  df.first_value("value", {"grp"}, "score", "first");
+  df.last_value("value", {"grp"}, "score", "last");
+
+  EXPECT_EQ(values_of<int64_t>(df, "first"),
+            (std::vector<int64_t>{1, 1, 1, 1, 6, 6}));
+  EXPECT_EQ(values_of<int64_t>(df, "last"),
+            (std::vector<int64_t>{4, 4, 4, 4, 5, 5}));
+}
+
+TEST_F(WindowTest, MissingColumnsThrow) {
+  EXPECT_THROW(df.rank({"grp"}, "missing", "out"), std::invalid_argument);
+  EXPECT_THROW(df.lag("missing", 1, {"grp"}, "score", "out"),
+               std::invalid_argument);
+}